@@ -0,0 +1,114 @@
+#include "test_common.hpp"
+
+#include <cstdio>
+
+using namespace winSignal;
+using winSignalTest::Report;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+static int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// send-to-consume latency of every item, recorded on the consumer thread
+struct Latencies
+{
+    std::vector<int64_t> samples;
+    std::atomic<int> received = 0;
+
+    explicit Latencies(int count) : samples(count)
+    {
+    }
+
+    void Record(int64_t sent)
+    {
+        samples[received.load(std::memory_order_relaxed)] = NowNs() - sent;
+        received.fetch_add(1, std::memory_order_release);
+    }
+
+    void Print(const char *name)
+    {
+        std::sort(samples.begin(), samples.end());
+        std::printf("%-48s p50 %10.1f us  p99 %10.1f us\n", name,
+                    samples[samples.size() / 2] / 1000.0, samples[samples.size() * 99 / 100] / 1000.0);
+    }
+};
+
+class Consumer : public EventLoopObject
+{
+public:
+    Latencies *latencies = nullptr;
+
+    void OnSent(int64_t sent)
+    {
+        latencies->Record(sent);
+    }
+};
+
+class Producer : public Object
+{
+public:
+    Signal<int64_t> sent;
+};
+
+template<typename Send>
+static void Run(const char *name, int count, Latencies &latencies, Send &&send)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        send();
+    }
+    WaitFor([&]() { return latencies.received.load(std::memory_order_acquire) == count; }, std::chrono::milliseconds(60000));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    Report(name, static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / count);
+    latencies.Print(name);
+}
+
+int main()
+{
+    const int count = 1000000;
+    Consumer consumer;
+    EventLoop *loop = WaitForLoop(consumer);
+
+    // one value per PostEvent
+    {
+        Latencies latencies(count);
+        Run("PostEvent per value", count, latencies, [&]()
+        {
+            loop->PostEvent([&latencies, sent = NowNs()]() { latencies.Record(sent); });
+        });
+    }
+
+    // one value per emission of a queued connection
+    {
+        Latencies latencies(count);
+        consumer.latencies = &latencies;
+        Producer producer;
+        Connect(&producer, &Producer::sent, &consumer, &Consumer::OnSent, ConnectionType::QueuedConnection);
+        Run("Connect(QueuedConnection) per value", count, latencies, [&]()
+        {
+            producer.sent.Emit(NowNs());
+        });
+        Disconnect(&producer, &Producer::sent, &consumer, &Consumer::OnSent);
+    }
+
+    // the same values through an SPSC channel, one wakeup per published batch
+    for (std::size_t capacity: { 1024u, 16384u })
+    {
+        Channel<int64_t> channel(loop, capacity);
+        Latencies latencies(count);
+        channel.OnReceive([&latencies](int64_t &sent) { latencies.Record(sent); });
+        std::string name = "Channel::TryPush, capacity " + std::to_string(capacity);
+        Run(name.c_str(), count, latencies, [&]()
+        {
+            while (!channel.TryPush(NowNs()))
+            {
+                std::this_thread::yield();
+            }
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include "test_common.hpp"
+
+#include <cstdio>
+#include <functional>
+
+using namespace winSignal;
+using winSignalTest::MeasureNs;
+using winSignalTest::Report;
+
+class Host : public EventLoopObject
+{
+};
+
+// a graph of computed nodes over one property, Targets() are the nodes read after every burst of writes
+struct LazyGraph
+{
+    Property<int> input{ nullptr, 0 };
+    std::vector<std::unique_ptr<Computed<int>>> nodes;
+    std::vector<Computed<int> *> targets;
+
+    std::size_t Evaluations() const
+    {
+        std::size_t total = 0;
+        for (auto &node: nodes)
+        {
+            total += node->RecomputeCount();
+        }
+        return total;
+    }
+};
+
+// the same graph recomputed eagerly: every node is evaluated in dependency order on every write
+struct EagerGraph
+{
+    int input = 0;
+    std::vector<std::function<int(const std::vector<int> &, int)>> nodes;
+    std::vector<int> values;
+    std::vector<std::size_t> targets;
+    std::size_t evaluations = 0;
+
+    void Set(int value)
+    {
+        input = value;
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            values[i] = nodes[i](values, input);
+            ++evaluations;
+        }
+    }
+};
+
+static void BuildDeep(LazyGraph &lazy, EagerGraph &eager, int depth)
+{
+    lazy.nodes.emplace_back(new Computed<int>([&lazy]() { return lazy.input.Get() + 1; }, lazy.input));
+    for (int i = 1; i < depth; ++i)
+    {
+        Computed<int> &previous = *lazy.nodes.back();
+        lazy.nodes.emplace_back(new Computed<int>([&previous]() { return previous.Get() + 1; }, previous));
+    }
+    lazy.targets.push_back(lazy.nodes.back().get());
+
+    eager.nodes.emplace_back([](const std::vector<int> &, int input) { return input + 1; });
+    for (int i = 1; i < depth; ++i)
+    {
+        eager.nodes.emplace_back([i](const std::vector<int> &values, int) { return values[i - 1] + 1; });
+    }
+    eager.values.assign(eager.nodes.size(), 0);
+    eager.targets.push_back(eager.nodes.size() - 1);
+}
+
+static void BuildWide(LazyGraph &lazy, EagerGraph &eager, int width, int reads)
+{
+    for (int i = 0; i < width; ++i)
+    {
+        lazy.nodes.emplace_back(new Computed<int>([&lazy, i]() { return lazy.input.Get() * 3 + i; }, lazy.input));
+        eager.nodes.emplace_back([i](const std::vector<int> &, int input) { return input * 3 + i; });
+    }
+    for (int i = 0; i < reads; ++i)
+    {
+        lazy.targets.push_back(lazy.nodes[i].get());
+        eager.targets.push_back(static_cast<std::size_t>(i));
+    }
+    eager.values.assign(eager.nodes.size(), 0);
+}
+
+static void Compare(const char *name, LazyGraph &lazy, EagerGraph &eager, std::size_t bursts, int writesPerBurst)
+{
+    char label[96];
+    volatile int sink = 0;
+    int value = 0;
+    for (auto target: lazy.targets)
+    {
+        sink = target->Get();
+    }
+
+    std::size_t lazyBefore = lazy.Evaluations();
+    std::snprintf(label, sizeof(label), "computed lazy: %s", name);
+    double lazyNs = MeasureNs(bursts, [&](std::size_t)
+    {
+        for (int w = 0; w < writesPerBurst; ++w)
+        {
+            lazy.input.Set(++value);
+        }
+        for (auto target: lazy.targets)
+        {
+            sink = target->Get();
+        }
+    });
+    Report(label, lazyNs);
+    std::size_t lazyEvaluations = lazy.Evaluations() - lazyBefore;
+
+    value = 0;
+    std::size_t eagerBefore = eager.evaluations;
+    std::snprintf(label, sizeof(label), "computed eager: %s", name);
+    double eagerNs = MeasureNs(bursts, [&](std::size_t)
+    {
+        for (int w = 0; w < writesPerBurst; ++w)
+        {
+            eager.Set(++value);
+        }
+        for (auto target: eager.targets)
+        {
+            sink = eager.values[target];
+        }
+    });
+    Report(label, eagerNs);
+    std::size_t eagerEvaluations = eager.evaluations - eagerBefore;
+
+    std::printf("%-48s %12.1f lazy %12.1f eager evaluations per burst\n", name,
+                static_cast<double>(lazyEvaluations) / bursts, static_cast<double>(eagerEvaluations) / bursts);
+}
+
+static void Run()
+{
+    const int writesPerBurst = 8;
+    char name[96];
+
+    for (int depth: { 16, 64, 256 })
+    {
+        LazyGraph lazy;
+        EagerGraph eager;
+        BuildDeep(lazy, eager, depth);
+        std::snprintf(name, sizeof(name), "deep %d, %d writes, read tail", depth, writesPerBurst);
+        Compare(name, lazy, eager, 20000 / depth, writesPerBurst);
+    }
+
+    for (int width: { 16, 256, 4096 })
+    {
+        LazyGraph lazy;
+        EagerGraph eager;
+        BuildWide(lazy, eager, width, 1);
+        std::snprintf(name, sizeof(name), "wide %d, %d writes, read 1", width, writesPerBurst);
+        Compare(name, lazy, eager, 200000 / width, writesPerBurst);
+    }
+
+    for (int width: { 16, 256, 4096 })
+    {
+        LazyGraph lazy;
+        EagerGraph eager;
+        BuildWide(lazy, eager, width, width);
+        std::snprintf(name, sizeof(name), "wide %d, %d writes, read all", width, writesPerBurst);
+        Compare(name, lazy, eager, 200000 / width, writesPerBurst);
+    }
+
+    // writes to unrelated graphs must not make a clean graph re-check its inputs
+    LazyGraph quiet;
+    EagerGraph unused;
+    BuildDeep(quiet, unused, 256);
+    std::vector<std::unique_ptr<LazyGraph>> others;
+    for (int i = 0; i < 64; ++i)
+    {
+        others.emplace_back(new LazyGraph);
+        others.back()->nodes.emplace_back(new Computed<int>([graph = others.back().get()]() { return graph->input.Get(); }, others.back()->input));
+    }
+    volatile int sink = quiet.targets.front()->Get();
+    Report("computed: Get on a clean 256 deep graph", MeasureNs(200000, [&](std::size_t) { sink = quiet.targets.front()->Get(); }));
+    Report("computed: unrelated write + clean Get", MeasureNs(200000, [&](std::size_t i)
+    {
+        others[i % others.size()]->input.Set(static_cast<int>(i) + 1);
+        sink = quiet.targets.front()->Get();
+    }));
+}
+
+int main()
+{
+    // run on a loop so notifications coalesce per iteration as they do in an application
+    Host host;
+    winSignalTest::RunOn(host, []() { Run(); });
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <string>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+
+/**
+ * @brief ramp the offered load step by step and report queueing latency and pool size at every step
+ * - every task sleeps instead of burning CPU, so extra threads help even on a small machine
+ */
+void Ramp(const char *name, const ElasticLoopPool::Options &options)
+{
+    const int strands = 16;
+    const auto task = std::chrono::microseconds(200);
+    const auto step = std::chrono::milliseconds(500);
+    const auto tick = std::chrono::milliseconds(1);
+
+    ElasticLoopPool pool(options);
+    std::vector<std::shared_ptr<Strand>> strandList;
+    for (int i = 0; i < strands; ++i)
+    {
+        strandList.push_back(pool.CreateStrand());
+    }
+
+    std::printf("%s\n", name);
+    for (int rate: { 1000, 2500, 5000, 10000, 15000 })
+    {
+        const int perTick = rate / 1000;
+        const int count = static_cast<int>(perTick * (step / tick));
+        std::vector<int64_t> latencies(count);
+        std::atomic<int> done = 0;
+        auto start = std::chrono::steady_clock::now();
+        auto next = start;
+        for (int i = 0; i < count;)
+        {
+            for (int n = 0; n < perTick; ++n, ++i)
+            {
+                strandList[i % strands]->Post([&latencies, &done, task, i, posted = std::chrono::steady_clock::now()]()
+                {
+                    latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - posted).count();
+                    std::this_thread::sleep_for(task);
+                    done.fetch_add(1, std::memory_order_release);
+                });
+            }
+            next += tick;
+            std::this_thread::sleep_until(next);
+        }
+        std::size_t threads = pool.ThreadCount();
+        WaitFor([&]() { return done.load(std::memory_order_acquire) == count; }, std::chrono::milliseconds(120000));
+        std::sort(latencies.begin(), latencies.end());
+        std::printf("  offered %6d tasks/s  p50 %10.1f us  p99 %10.1f us  threads %zu\n", rate,
+                    latencies[latencies.size() / 2] / 1000.0, latencies[latencies.size() * 99 / 100] / 1000.0, threads);
+    }
+}
+
+int main()
+{
+    const std::size_t threads = 4;
+
+    ElasticLoopPool::Options fixed;
+    fixed.minThreads = 1;
+    fixed.maxThreads = 1;
+    Ramp("fixed pool, 1 thread", fixed);
+
+    ElasticLoopPool::Options elastic;
+    elastic.minThreads = 1;
+    elastic.maxThreads = threads;
+    elastic.sampleInterval = std::chrono::milliseconds(10);
+    elastic.growLag = std::chrono::milliseconds(1);
+    std::string name = "elastic pool, 1.." + std::to_string(threads) + " threads";
+    Ramp(name.c_str(), elastic);
+    return 0;
+}
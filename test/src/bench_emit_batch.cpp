@@ -0,0 +1,70 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::Report;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+class Source : public Object
+{
+public:
+    Signal<int> value;
+};
+
+class Sink : public Object
+{
+public:
+    std::atomic<int> received = 0;
+
+    void OnValue(int)
+    {
+        ++received;
+    }
+};
+
+int main()
+{
+    const int count = 1 << 20;
+    const int batch = 256;
+    Host host;
+    WaitForLoop(host);
+    Source source;
+    Sink sink;
+    sink.MoveToThread(host.ThreadId());
+    Connect(&source, &Source::value, &sink, &Sink::OnValue, ConnectionType::QueuedConnection);
+
+    // one queued post per value
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i)
+        {
+            source.value.Emit(i);
+        }
+        WaitFor([&]() { return sink.received == count; }, std::chrono::milliseconds(60000));
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Report("Emit per value, queued", static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / count);
+    }
+
+    // one queued post per batch of values
+    {
+        sink.received = 0;
+        std::vector<std::tuple<int>> items(batch);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i += batch)
+        {
+            for (int j = 0; j < batch; ++j)
+            {
+                items[j] = std::make_tuple(i + j);
+            }
+            source.value.EmitBatch(items);
+        }
+        WaitFor([&]() { return sink.received == count; }, std::chrono::milliseconds(60000));
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Report("EmitBatch of 256, queued", static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / count);
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::Report;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+class Receiver : public Object
+{
+};
+
+/**
+ * @brief latency of a single event queued behind a flood of events for another receiver
+ */
+double QuietLatency(bool fair)
+{
+    const int flood = 20000;
+    Host host;
+    WaitForLoop(host)->SetFairScheduling(fair, 64);
+    Receiver busy, quiet;
+    busy.MoveToThread(host.ThreadId());
+    quiet.MoveToThread(host.ThreadId());
+
+    double total = 0;
+    const int rounds = 20;
+    for (int round = 0; round < rounds; ++round)
+    {
+        std::atomic<int> done = 0;
+        std::atomic<bool> quietDone = false;
+        for (int i = 0; i < flood; ++i)
+        {
+            busy.InvokeMethod([&done]()
+            {
+                volatile int spin = 0;
+                for (int j = 0; j < 100; ++j)
+                {
+                    spin = spin + j;
+                }
+                ++done;
+            });
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point end;
+        quiet.InvokeMethod([&]()
+        {
+            end = std::chrono::steady_clock::now();
+            quietDone = true;
+        });
+        WaitFor([&]() { return quietDone && done == flood; }, std::chrono::milliseconds(60000));
+        total += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+    return total / rounds;
+}
+
+int main()
+{
+    Report("quiet receiver latency, FIFO", QuietLatency(false));
+    Report("quiet receiver latency, fair", QuietLatency(true));
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <cstdlib>
+#include <map>
+#include <new>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::Report;
+using winSignalTest::WaitForLoop;
+
+static std::atomic<std::size_t> g_Allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    ++g_Allocations;
+    if (void *pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    std::abort();
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+class Host : public EventLoopObject
+{
+};
+
+/**
+ * @brief run bursts of events that each call work, report time and heap allocations per event
+ * - every burst is waited for, so one loop iteration handles one burst like a frame would
+ */
+template<typename Work>
+void Run(Host &host, const char *name, Work &&work)
+{
+    const int bursts = 2000;
+    const int burst = 64;
+    EventLoop *loop = host.GetEventLoop();
+    std::size_t allocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < bursts; ++i)
+    {
+        for (int j = 0; j < burst; ++j)
+        {
+            host.InvokeMethod([&]()
+            {
+                std::size_t before = g_Allocations.load(std::memory_order_relaxed);
+                work();
+                allocations += g_Allocations.load(std::memory_order_relaxed) - before;
+            });
+        }
+        loop->SendEvent([]() {});
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    const double events = static_cast<double>(bursts) * burst;
+    Report(name, static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / events);
+    std::printf("%-48s %12.2f allocations per event\n", name, static_cast<double>(allocations) / events);
+}
+
+template<typename Vector>
+void FillVector(Vector &&scratch)
+{
+    scratch.reserve(256);
+    for (int i = 0; i < 256; ++i)
+    {
+        scratch.push_back(i);
+    }
+}
+
+template<typename Map>
+void FillMap(Map &&scratch)
+{
+    for (int i = 0; i < 64; ++i)
+    {
+        scratch.emplace((i * 37) % 64, i);
+    }
+}
+
+int main()
+{
+    Host host;
+    WaitForLoop(host);
+
+    // one contiguous scratch buffer per event
+    Run(host, "std::vector scratch", []() { FillVector(std::vector<int>()); });
+    Run(host, "std::pmr::vector on FrameResource", []() { FillVector(std::pmr::vector<int>(FrameResource())); });
+
+    // node based scratch, one heap allocation per node without the arena
+    Run(host, "std::map scratch", []() { FillMap(std::map<int, int>()); });
+    Run(host, "std::pmr::map on FrameResource", []() { FillMap(std::pmr::map<int, int>(FrameResource())); });
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <string>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::Report;
+using winSignalTest::WaitFor;
+
+struct Feed
+{
+    Signal<int, int> update;
+};
+
+// per-key state, only ever touched by the loop its key is routed to, so it needs no lock
+struct alignas(64) KeyState
+{
+    uint64_t value = 0;
+};
+
+static uint64_t Work(uint64_t value, int sequence, int rounds)
+{
+    for (int i = 0; i < rounds; ++i)
+    {
+        value ^= value << 13;
+        value ^= value >> 7;
+        value ^= value << 17;
+        value += static_cast<uint64_t>(sequence);
+    }
+    return value;
+}
+
+int main()
+{
+    const int count = 200000;
+    const int keys = 64;
+    std::size_t cores = (std::max)(std::thread::hardware_concurrency(), 1u);
+
+    for (int rounds: { 0, 256, 2048 })
+    {
+        for (std::size_t loops = 1; loops <= (std::max)(cores * 2, static_cast<std::size_t>(4)); loops *= 2)
+        {
+            EventLoopGroup group(loops);
+            Feed feed;
+            std::vector<KeyState> states(keys);
+            std::atomic<int> received = 0;
+            ConnectByKey(&feed, &Feed::update, &group, KeyArgument<0>(), [&, rounds](int key, int sequence)
+            {
+                states[key].value = Work(states[key].value + 1, sequence, rounds);
+                received.fetch_add(1, std::memory_order_relaxed);
+            });
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < count; ++i)
+            {
+                feed.update.Emit(i % keys, i);
+            }
+            WaitFor([&]() { return received == count; }, std::chrono::milliseconds(120000));
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            std::string name = "ConnectByKey, " + std::to_string(rounds) + " rounds/item, " + std::to_string(loops) + " loops";
+            Report(name.c_str(), static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / count);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <random>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::Report;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+/**
+ * @brief nanoseconds per element of start(finish) on the host loop until finish is called
+ */
+template<typename Start>
+double TimeOnLoop(Host &host, std::size_t elements, Start &&start)
+{
+    std::atomic<bool> done = false;
+    auto begin = std::chrono::steady_clock::now();
+    host.InvokeMethod([&]() { start([&done]() { done = true; }); });
+    WaitFor([&]() { return done.load(); }, std::chrono::milliseconds(120000));
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(elements);
+}
+
+static void Run(Host &host, std::size_t size)
+{
+    std::vector<double> data(size);
+    std::mt19937 random(1);
+    for (auto &value: data)
+    {
+        value = static_cast<double>(random() % 1000000);
+    }
+    std::vector<double> output(size);
+    std::string suffix = ", " + std::to_string(size) + " elements, per element";
+    auto name = [&suffix](const char *what) { return std::string(what) + suffix; };
+
+    auto transform = [&](std::size_t i) { output[i] = data[i] * data[i] + 1.0; };
+    Report(name("serial for").c_str(), TimeOnLoop(host, size, [&](auto finish)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            transform(i);
+        }
+        finish();
+    }));
+    Report(name("ParallelFor").c_str(), TimeOnLoop(host, size, [&](auto finish)
+    {
+        ParallelFor(std::size_t(0), size, transform, finish);
+    }));
+
+    Report(name("std::accumulate").c_str(), TimeOnLoop(host, size, [&](auto finish)
+    {
+        volatile double sum = std::accumulate(data.begin(), data.end(), 0.0);
+        (void)sum;
+        finish();
+    }));
+    Report(name("ParallelReduce").c_str(), TimeOnLoop(host, size, [&](auto finish)
+    {
+        ParallelReduce(data.begin(), data.end(), 0.0, std::plus<>(), [finish](double) { finish(); });
+    }));
+
+    std::vector<double> copy = data;
+    Report(name("std::sort").c_str(), TimeOnLoop(host, size, [&](auto finish)
+    {
+        std::sort(copy.begin(), copy.end());
+        finish();
+    }));
+    copy = data;
+    Report(name("ParallelSort").c_str(), TimeOnLoop(host, size, [&](auto finish)
+    {
+        ParallelSort(copy.begin(), copy.end(), finish);
+    }));
+}
+
+/**
+ * @brief without arguments rerun this binary once per worker count, with a count run every size on that many workers
+ * - the pool is sized once per process, so every count needs its own process
+ */
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::size_t cores = (std::max)(std::thread::hardware_concurrency(), 1u);
+        for (std::size_t workers = 1; workers <= (std::max)(cores, static_cast<std::size_t>(2)); workers *= 2)
+        {
+            std::string command = std::string("\"") + argv[0] + "\" " + std::to_string(workers);
+            if (std::system(command.c_str()) != 0)
+            {
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    std::size_t workers = static_cast<std::size_t>(std::strtoul(argv[1], nullptr, 10));
+    SetParallelWorkerCount(workers);
+    std::printf("%zu workers\n", Implementation::WorkStealingPool::GetInstance()->Size());
+    Host host;
+    WaitForLoop(host);
+    for (std::size_t size: { std::size_t(1) << 16, std::size_t(1) << 20, std::size_t(1) << 23 })
+    {
+        Run(host, size);
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Source : public Object
+{
+public:
+    Signal<int64_t, float> tick;
+    Signal<bool> toggled;
+};
+
+class Sink : public EventLoopObject
+{
+public:
+    std::atomic<int> calls = 0;
+    std::atomic<int> total = 0;
+    double sum = 0;
+};
+
+class Receiver : public Object
+{
+public:
+    std::atomic<int> total = 0;
+};
+
+int main()
+{
+    // everything emitted while the receiver is busy arrives as one batch, one column per argument
+    Source source;
+    auto sink = new Sink;
+    WaitForLoop(*sink);
+    ConnectBatched(&source, &Source::tick, sink, [sink](Span<const int64_t> ids, Span<const float> values)
+    {
+        ++sink->calls;
+        sink->total += static_cast<int>(ids.Size());
+        for (auto value: values)
+        {
+            sink->sum += value;
+        }
+    });
+    std::atomic<bool> release = false;
+    sink->InvokeMethod([&]() { WaitFor([&]() { return release.load(); }); });
+    for (int i = 0; i < 1000; ++i)
+    {
+        source.tick.Emit(i, 0.5f);
+    }
+    release = true;
+    WS_CHECK(WaitFor([&]() { return sink->total == 1000; }));
+    RunOn(*sink, []() {});
+    WS_CHECK(sink->calls == 1);
+    WS_CHECK(sink->sum == 500.0);
+    delete sink;
+    source.tick.Emit(1, 1.0f);
+
+    // bool arguments arrive as a contiguous column as well
+    Sink flags;
+    WaitForLoop(flags);
+    std::atomic<int> set = 0;
+    ConnectBatched(&source, &Source::toggled, &flags, [&](Span<const bool> values)
+    {
+        for (bool value: values)
+        {
+            set += value ? 1 : 0;
+        }
+        flags.total += static_cast<int>(values.Size());
+    });
+    for (int i = 0; i < 100; ++i)
+    {
+        source.toggled.Emit(i % 4 == 0);
+    }
+    WS_CHECK(WaitFor([&]() { return flags.total == 100; }));
+    WS_CHECK(set == 25);
+
+    // emissions before the receiver's loop exists are dropped instead of blocking later batches
+    std::atomic<bool> start = false;
+    std::atomic<EventLoop *> late = nullptr;
+    std::thread worker([&]()
+    {
+        WaitFor([&]() { return start.load(); });
+        EventLoop loop;
+        late = &loop;
+        loop.Run();
+    });
+    Receiver receiver;
+    receiver.MoveToThread(worker.get_id());
+    ConnectBatched(&source, &Source::tick, &receiver, [&](Span<const int64_t> ids, Span<const float>)
+    {
+        receiver.total += static_cast<int>(ids.Size());
+    });
+    source.tick.Emit(1, 1.0f);
+    source.tick.Emit(2, 1.0f);
+    start = true;
+    WaitFor([&]() { return late.load() != nullptr && GetEventLoop(worker.get_id()) != nullptr; });
+    source.tick.Emit(3, 1.0f);
+    WS_CHECK(WaitFor([&]() { return receiver.total == 1; }));
+    late.load()->SendEvent([&]() { late.load()->Quit(); });
+    worker.join();
+    return winSignalTest::Finish("batched");
+}
@@ -0,0 +1,69 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+int main()
+{
+    const std::size_t count = 8;
+    std::vector<std::unique_ptr<Host>> hosts;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        hosts.push_back(std::make_unique<Host>());
+        WaitForLoop(*hosts.back());
+    }
+
+    // every loop runs func once and the caller sees all of them finish
+    std::atomic<int> runs = 0;
+    BroadcastResult result = BroadcastAndWait([&runs]() { ++runs; });
+    WS_CHECK(result.loops == count);
+    WS_CHECK(result.completed == count);
+    WS_CHECK(!result.wouldDeadlock);
+    WS_CHECK(runs == static_cast<int>(count));
+
+    // a finished broadcast always reports the latency of its last arrival
+    for (int round = 0; round < 200; ++round)
+    {
+        result = BroadcastAndWait([]() {}, std::chrono::milliseconds(50));
+        if (result.completed == result.loops)
+        {
+            WS_CHECK(result.latency > std::chrono::steady_clock::duration::zero());
+        }
+    }
+
+    // asynchronous broadcast reports completion through done
+    std::atomic<bool> done = false;
+    runs = 0;
+    WS_CHECK(Broadcast([&runs]() { ++runs; }, [&done](std::chrono::steady_clock::duration) { done = true; }) == count);
+    WS_CHECK(WaitFor([&]() { return done.load(); }));
+    WS_CHECK(runs == static_cast<int>(count));
+
+    // two loops broadcasting at the same time do not wait on each other and say so
+    runs = 0;
+    std::atomic<int> returned = 0;
+    std::atomic<int> flagged = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        hosts[i]->InvokeMethod([&]()
+        {
+            BroadcastResult inner = BroadcastAndWait([&runs]() { ++runs; });
+            returned += inner.loops == count && inner.completed >= 1;
+            flagged += inner.wouldDeadlock;
+        });
+    }
+    WS_CHECK(WaitFor([&]() { return returned == 2; }));
+    WS_CHECK(flagged == 2);
+    WS_CHECK(WaitFor([&]() { return runs == static_cast<int>(2 * count); }));
+
+    // a timeout returns with the loops that finished so far
+    std::atomic<bool> release = false;
+    result = BroadcastAndWait([&release]() { WaitFor([&release]() { return release.load(); }); }, std::chrono::milliseconds(20));
+    WS_CHECK(result.completed < count);
+    release = true;
+    return winSignalTest::Finish("broadcast");
+}
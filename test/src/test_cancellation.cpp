@@ -0,0 +1,73 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+struct Payload
+{
+    static inline std::atomic<int> alive = 0;
+
+    Payload()
+    {
+        ++alive;
+    }
+
+    Payload(const Payload &)
+    {
+        ++alive;
+    }
+
+    ~Payload()
+    {
+        --alive;
+    }
+};
+
+int main()
+{
+    Host host;
+    WaitForLoop(host);
+    std::atomic<int> ran = 0;
+
+    // cancelled posts never run and release their captures right away
+    std::atomic<bool> release = false;
+    host.InvokeMethod([&release]() { WaitFor([&release]() { return release.load(); }); });
+    CancellationGroup group;
+    for (int i = 0; i < 100; ++i)
+    {
+        Payload payload;
+        group.Add(host.InvokeMethodCancelable([payload, &ran]() { ++ran; }));
+    }
+    TaskHandle keep = host.InvokeMethodCancelable([&ran]() { ran += 1000; });
+    WS_CHECK(Payload::alive == 100);
+    WS_CHECK(keep.IsPending());
+    WS_CHECK(group.Cancel() == 100);
+    WS_CHECK(Payload::alive == 0);
+    release = true;
+    WS_CHECK(WaitFor([&]() { return !keep.IsPending(); }));
+    WS_CHECK(ran == 1000);
+
+    // a finished task can not be cancelled any more
+    WS_CHECK(!keep.Cancel());
+    WS_CHECK(!keep.IsCancelled());
+
+    // delayed work can be withdrawn before it fires
+    TaskHandle fires = host.InvokeMethodDelayed(20, [&ran]() { ran += 5; });
+    TaskHandle withdrawn = host.InvokeMethodDelayed(20, [&ran]() { ran += 7; });
+    WS_CHECK(withdrawn.Cancel());
+    WS_CHECK(withdrawn.IsCancelled());
+    WS_CHECK(WaitFor([&]() { return !fires.IsPending(); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    WS_CHECK(ran == 1005);
+
+    // an empty handle is inert
+    TaskHandle empty;
+    WS_CHECK(!empty);
+    WS_CHECK(!empty.Cancel());
+    return winSignalTest::Finish("cancellation");
+}
@@ -0,0 +1,83 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Consumer : public EventLoopObject
+{
+};
+
+int main()
+{
+    Consumer consumer;
+    Channel<int> channel(WaitForLoop(consumer), 256);
+    WS_CHECK(channel.Capacity() == 256);
+
+    std::atomic<int> received = 0;
+    std::atomic<bool> ordered = true;
+    std::atomic<bool> onConsumer = true;
+    int expected = 0;
+    channel.OnReceive([&](int &value)
+    {
+        ordered = ordered && value == expected++;
+        onConsumer = onConsumer && std::this_thread::get_id() == consumer.ThreadId();
+        ++received;
+    });
+
+    // a producer faster than the consumer sees back pressure instead of losing values
+    std::thread producer([&]()
+    {
+        for (int i = 0; i < 200000;)
+        {
+            if (channel.TryPush(i))
+            {
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        std::vector<int> batch(100);
+        for (int i = 0; i < 100; ++i)
+        {
+            batch[i] = 200000 + i;
+        }
+        auto next = batch.begin();
+        while ((next = channel.PushBatch(next, batch.end())) != batch.end())
+        {
+            std::this_thread::yield();
+        }
+    });
+    producer.join();
+    WS_CHECK(WaitFor([&]() { return received == 200100; }));
+    WS_CHECK(ordered);
+    WS_CHECK(onConsumer);
+
+    // writes stay invisible until Publish, a full ring rejects further writes
+    Channel<int> manual(nullptr, 4);
+    std::vector<int> seen;
+    manual.OnReceive([&](int &value) { seen.push_back(value); });
+    for (int i = 0; i < 4; ++i)
+    {
+        WS_CHECK(manual.TryWrite(i));
+    }
+    WS_CHECK(!manual.TryWrite(4));
+    WS_CHECK(manual.Consume() == 0);
+    manual.Publish();
+    WS_CHECK(manual.Consume() == 4);
+    WS_CHECK((seen == std::vector<int>{ 0, 1, 2, 3 }));
+    WS_CHECK(manual.TryPush(5));
+    WS_CHECK(manual.Consume() == 1);
+
+    // consumed values are moved out, the ring does not keep them alive
+    Channel<std::shared_ptr<int>> owning(nullptr, 4);
+    std::shared_ptr<int> kept;
+    owning.OnReceive([&](std::shared_ptr<int> &value) { kept = value; });
+    WS_CHECK(owning.TryPush(std::make_shared<int>(7)));
+    WS_CHECK(owning.Consume() == 1);
+    WS_CHECK(kept && *kept == 7 && kept.use_count() == 1);
+    return winSignalTest::Finish("channel");
+}
@@ -0,0 +1,91 @@
+#ifndef __WIN_SIGNAL_TEST_COMMON_HPP__
+#define __WIN_SIGNAL_TEST_COMMON_HPP__
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include "../winsignal.hpp"
+
+namespace winSignalTest
+{
+    inline int &Failures()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline void Check(bool condition, const char *expression, const char *file, int line)
+    {
+        if (!condition)
+        {
+            std::printf("%s:%d: check failed: %s\n", file, line, expression);
+            ++Failures();
+        }
+    }
+
+    /**
+     * @brief poll predicate until it holds or timeout expires
+     */
+    template<typename Predicate>
+    bool WaitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000))
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    /**
+     * @brief wait until the loop thread of object has registered its event loop
+     */
+    inline winSignal::EventLoop *WaitForLoop(winSignal::Object &object)
+    {
+        WaitFor([&]() { return object.GetEventLoop() != nullptr; });
+        return object.GetEventLoop();
+    }
+
+    /**
+     * @brief run func on the loop of object and wait until it returned
+     */
+    template<typename Func>
+    void RunOn(winSignal::Object &object, Func &&func)
+    {
+        WaitForLoop(object)->SendEvent(std::forward<Func>(func));
+    }
+
+    /**
+     * @brief average nanoseconds per call of func(i) over iterations calls
+     */
+    template<typename Func>
+    double MeasureNs(std::size_t iterations, Func &&func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            func(i);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(iterations);
+    }
+
+    inline void Report(const char *name, double nanoseconds)
+    {
+        std::printf("%-48s %12.1f ns\n", name, nanoseconds);
+    }
+
+    inline int Finish(const char *name)
+    {
+        std::printf("%s: %s\n", name, Failures() == 0 ? "passed" : "failed");
+        return Failures() == 0 ? 0 : 1;
+    }
+}
+
+#define WS_CHECK(condition) winSignalTest::Check((condition), #condition, __FILE__, __LINE__)
+
+#endif // __WIN_SIGNAL_TEST_COMMON_HPP__
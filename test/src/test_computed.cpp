@@ -0,0 +1,80 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+int main()
+{
+    // diamond: sum -> twice -> mix, recomputed lazily and once per read
+    Property<int> a(nullptr, 1), b(nullptr, 2);
+    Computed<int> sum([&]() { return a.Get() + b.Get(); }, a, b);
+    Computed<int> twice([&]() { return sum.Get() * 2; }, sum);
+    Computed<int> mix([&]() { return sum.Get() + twice.Get(); }, sum, twice);
+    WS_CHECK(mix.Get() == 9);
+    WS_CHECK(sum.RecomputeCount() == 1);
+    a = 5;
+    WS_CHECK(mix.IsDirty());
+    WS_CHECK(mix.Get() == 21);
+    WS_CHECK(sum.RecomputeCount() == 2 && twice.RecomputeCount() == 2 && mix.RecomputeCount() == 2);
+    WS_CHECK(mix.Get() == 21);
+    WS_CHECK(mix.RecomputeCount() == 2);
+
+    std::vector<int> seen;
+    Connect(&mix, &Computed<int>::changed, [&](int value) { seen.push_back(value); });
+    b = 3;
+    WS_CHECK(seen.size() == 1 && seen[0] == 24);
+
+    // an input that changes back to the same derived value does not ripple further
+    Property<int> sign(nullptr, 4);
+    Computed<bool> positive([&]() { return sign.Get() > 0; }, sign);
+    Computed<int> label([&]() { return positive.Get() ? 1 : -1; }, positive);
+    WS_CHECK(label.Get() == 1);
+    sign = 7;
+    WS_CHECK(label.Get() == 1);
+    WS_CHECK(positive.RecomputeCount() == 2 && label.RecomputeCount() == 1);
+
+    // on a loop, a write is visible to the next Get() before the coalesced notification runs
+    Host host;
+    WaitForLoop(host);
+    std::atomic<int> emits = 0;
+    std::atomic<bool> fresh = false;
+    std::unique_ptr<Property<int>> x;
+    std::unique_ptr<Computed<int>> y;
+    RunOn(host, [&]()
+    {
+        x.reset(new Property<int>(&host, 0));
+        y.reset(new Computed<int>([&]() { return x->Get() * 10; }, *x));
+        Connect(y.get(), &Computed<int>::changed, [&](int) { ++emits; });
+    });
+    RunOn(host, [&]()
+    {
+        bool ok = true;
+        for (int i = 1; i < 100; ++i)
+        {
+            x->Set(i);
+            ok = ok && y->Get() == i * 10;
+        }
+        fresh = ok;
+    });
+    WS_CHECK(fresh);
+    WS_CHECK(WaitFor([&]() { return emits == 1; }));
+
+    // a write from another thread is seen by the next Get() on the owner's thread
+    x->Set(500);
+    std::atomic<int> read = 0;
+    RunOn(host, [&]() { read = y->Get(); });
+    WS_CHECK(read == 5000);
+
+    RunOn(host, [&]()
+    {
+        y.reset();
+        x.reset();
+    });
+    return winSignalTest::Finish("computed");
+}
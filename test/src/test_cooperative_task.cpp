@@ -0,0 +1,89 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+int main()
+{
+    Host host;
+    EventLoop *loop = WaitForLoop(host);
+    loop->SetSliceBudget(std::chrono::milliseconds(2));
+
+    // a long computation runs in slices, the loop keeps serving events and timers in between
+    const uint64_t steps = 3000000;
+    volatile double accumulator = 0;
+    std::atomic<uint64_t> step = 0;
+    auto task = CooperativeTask::Create(loop, [&]()
+    {
+        for (int k = 0; k < 100; ++k)
+        {
+            accumulator = accumulator + k;
+        }
+        return ++step < steps;
+    });
+    std::atomic<int> progress = 0;
+    std::atomic<bool> finished = false;
+    std::atomic<bool> completed = false;
+    Connect(task.get(), &CooperativeTask::progress, [&progress](uint64_t) { ++progress; });
+    Connect(task.get(), &CooperativeTask::finished, [&](uint64_t count, bool complete)
+    {
+        completed = complete && count == steps;
+        finished = true;
+    });
+    std::atomic<bool> timerFired = false;
+    host.InvokeMethod([&timerFired]() { Timer::SingleShot(10, [&timerFired]() { timerFired = true; }); });
+    task->Start();
+
+    long long maxLatency = 0;
+    for (int k = 0; k < 50 && !finished; ++k)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::atomic<bool> ran = false;
+        host.InvokeMethod([&ran]() { ran = true; });
+        WaitFor([&ran]() { return ran.load(); });
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        maxLatency = (std::max)(maxLatency, static_cast<long long>(latency));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    WS_CHECK(WaitFor([&]() { return finished.load(); }, std::chrono::milliseconds(60000)));
+    WS_CHECK(completed);
+    WS_CHECK(progress > 5);
+    WS_CHECK(maxLatency < 50000);
+    WS_CHECK(timerFired);
+    WS_CHECK(task->IsFinished());
+
+    // a second Start does not schedule a second chain of slices
+    std::atomic<int> running = 0;
+    std::atomic<bool> overlapped = false;
+    std::atomic<uint64_t> counted = 0;
+    auto twice = CooperativeTask::Create(loop, [&]()
+    {
+        overlapped = overlapped || ++running > 1;
+        --running;
+        return ++counted < 100000;
+    });
+    std::atomic<uint64_t> reported = 0;
+    Connect(twice.get(), &CooperativeTask::finished, [&reported](uint64_t count, bool) { reported = count; });
+    twice->Start();
+    twice->Start();
+    WS_CHECK(WaitFor([&]() { return twice->IsFinished(); }));
+    WS_CHECK(WaitFor([&]() { return reported == 100000; }));
+    WS_CHECK(counted == 100000);
+    WS_CHECK(!overlapped);
+
+    // cancel stops an endless task and reports it as incomplete
+    auto endless = CooperativeTask::Create(loop, []() { return true; });
+    std::atomic<bool> cancelled = false;
+    Connect(endless.get(), &CooperativeTask::finished, [&cancelled](uint64_t, bool complete) { cancelled = !complete; });
+    endless->Start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    endless->Cancel();
+    WS_CHECK(WaitFor([&]() { return cancelled.load(); }));
+    WS_CHECK(endless->IsFinished());
+    return winSignalTest::Finish("cooperative_task");
+}
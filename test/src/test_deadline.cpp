@@ -0,0 +1,80 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+class Source : public Object
+{
+public:
+    Signal<int> frame;
+};
+
+class Sink : public Object
+{
+public:
+    std::vector<int> order;
+
+    void OnFrame(int value)
+    {
+        order.push_back(value);
+    }
+};
+
+int main()
+{
+    Host host;
+    EventLoop *loop = WaitForLoop(host);
+    Source source;
+    Sink sink;
+    sink.MoveToThread(host.ThreadId());
+    Connect(&source, &Source::frame, &sink, &Sink::OnFrame, ConnectionType::QueuedConnection);
+
+    // deadline tagged deliveries run first, earliest deadline first
+    std::atomic<bool> release = false;
+    host.InvokeMethod([&release]() { WaitFor([&release]() { return release.load(); }); });
+    auto now = std::chrono::steady_clock::now();
+    source.frame.Emit(1);
+    source.frame.Emit(2);
+    source.frame.EmitBefore(now + std::chrono::seconds(20), 20);
+    source.frame.EmitBefore(now + std::chrono::seconds(10), 10);
+    release = true;
+    std::vector<int> order;
+    WS_CHECK(WaitFor([&]()
+    {
+        RunOn(host, [&]() { order = sink.order; });
+        return order.size() == 4;
+    }));
+    WS_CHECK((order == std::vector<int>{ 10, 20, 1, 2 }));
+    WS_CHECK(loop->DeadlineMisses() == 0);
+
+    // an expired delivery is counted as a miss and still runs by default
+    RunOn(host, [&]() { sink.order.clear(); });
+    source.frame.EmitBefore(std::chrono::steady_clock::now() - std::chrono::milliseconds(1), 99);
+    WS_CHECK(WaitFor([&]()
+    {
+        RunOn(host, [&]() { order = sink.order; });
+        return order.size() == 1;
+    }));
+    WS_CHECK(loop->DeadlineMisses() == 1);
+    WS_CHECK(loop->DeadlineDrops() == 0);
+
+    // DropExpired skips it instead
+    RunOn(host, [&]() { sink.order.clear(); });
+    loop->SetDeadlinePolicy(DeadlinePolicy::DropExpired);
+    source.frame.EmitBefore(std::chrono::steady_clock::now() - std::chrono::milliseconds(1), 99);
+    source.frame.Emit(3);
+    WS_CHECK(WaitFor([&]()
+    {
+        RunOn(host, [&]() { order = sink.order; });
+        return order.size() == 1;
+    }));
+    WS_CHECK((order == std::vector<int>{ 3 }));
+    WS_CHECK(loop->DeadlineDrops() == 1);
+    return winSignalTest::Finish("deadline");
+}
@@ -0,0 +1,141 @@
+#include <cstdlib>
+#include <mutex>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+class Source : public Object
+{
+public:
+    Signal<int> value;
+    Signal<int> other;
+};
+
+class Sink : public Object
+{
+public:
+    std::vector<int> received;
+
+    void OnValue(int value)
+    {
+        received.push_back(value);
+    }
+};
+
+int main()
+{
+    // a direct slot may emit its own signal again after a loop change invalidated every cached plan
+    {
+        Source source;
+        std::atomic<int> calls = 0;
+        Connect(&source, &Source::value, [&source, &calls](int depth)
+        {
+            ++calls;
+            if (depth == 3)
+            {
+                Host transient;
+                WaitForLoop(transient);
+            }
+            if (depth > 0)
+            {
+                source.value.Emit(depth - 1);
+            }
+        });
+        std::atomic<bool> done = false;
+        std::thread emitter([&]()
+        {
+            for (int round = 0; round < 20; ++round)
+            {
+                source.value.Emit(3);
+            }
+            done = true;
+        });
+        bool finished = WaitFor([&]() { return done.load(); });
+        WS_CHECK(finished);
+        if (!finished)
+        {
+            emitter.detach();
+            return winSignalTest::Finish("dispatch_plan");
+        }
+        emitter.join();
+        WS_CHECK(calls == 80);
+    }
+
+    // a plan miss on a loop does not wait for the write lock while another emitter's blocking slot waits on that loop
+    {
+        Host host;
+        EventLoop *loop = WaitForLoop(host);
+        Source source;
+        Sink sink;
+        sink.MoveToThread(host.ThreadId());
+        Connect(&source, &Source::value, &sink, &Sink::OnValue, ConnectionType::BlockingQueuedConnection);
+        std::atomic<bool> inside = false;
+        Connect(&source, &Source::value, [&inside](int value)
+        {
+            if (value == 1)
+            {
+                inside = true;
+            }
+        });
+        loop->PostEvent([&]()
+        {
+            WaitFor([&]() { return inside.load(); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            source.value.Emit(2);
+        });
+        std::atomic<bool> done = false;
+        std::thread emitter([&]()
+        {
+            source.value.Emit(1);
+            done = true;
+        });
+        bool finished = WaitFor([&]() { return done.load(); });
+        WS_CHECK(finished);
+        if (!finished)
+        {
+            // the loop is deadlocked, destroying host would hang
+            emitter.detach();
+            std::_Exit(winSignalTest::Finish("dispatch_plan"));
+        }
+        emitter.join();
+        RunOn(host, [&]()
+        {
+            WS_CHECK(sink.received.size() == 2);
+        });
+    }
+
+    // receivers sharing a loop keep per-receiver order under fair scheduling
+    {
+        Host host;
+        WaitForLoop(host)->SetFairScheduling(true, 1);
+        Source source;
+        Sink first, second;
+        first.MoveToThread(host.ThreadId());
+        second.MoveToThread(host.ThreadId());
+        Connect(&source, &Source::value, &first, &Sink::OnValue, ConnectionType::QueuedConnection);
+        Connect(&source, &Source::value, &second, &Sink::OnValue, ConnectionType::QueuedConnection);
+        Connect(&source, &Source::other, &first, &Sink::OnValue, ConnectionType::QueuedConnection);
+
+        std::atomic<bool> release = false;
+        host.InvokeMethod([&release]() { WaitFor([&release]() { return release.load(); }); });
+        source.other.Emit(1);
+        source.other.Emit(2);
+        source.value.Emit(3);
+        release = true;
+        std::vector<int> received;
+        WS_CHECK(WaitFor([&]()
+        {
+            RunOn(host, [&]() { received = first.received; });
+            return received.size() == 3;
+        }));
+        WS_CHECK((received == std::vector<int>{ 1, 2, 3 }));
+    }
+    return winSignalTest::Finish("dispatch_plan");
+}
@@ -0,0 +1,90 @@
+#include <mutex>
+#include <set>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+
+int main()
+{
+    ElasticLoopPool::Options options;
+    options.minThreads = 1;
+    options.maxThreads = 4;
+    options.sampleInterval = std::chrono::milliseconds(20);
+    options.shrinkIdleSamples = 5;
+    ElasticLoopPool pool(options);
+    WS_CHECK(pool.ThreadCount() == 1);
+
+    std::atomic<std::size_t> peak = 0;
+    Connect(&pool, &ElasticLoopPool::resized, [&peak](std::size_t count)
+    {
+        std::size_t current = peak.load();
+        while (count > current && !peak.compare_exchange_weak(current, count))
+        {
+        }
+    });
+
+    // a backlog of slow tasks grows the pool, strands keep their order while moving between threads
+    const int strands = 8;
+    const int count = 4000;
+    std::vector<std::shared_ptr<Strand>> strandList;
+    for (int i = 0; i < strands; ++i)
+    {
+        strandList.push_back(pool.CreateStrand());
+    }
+    std::vector<std::vector<int>> seen(strands);
+    std::mutex threadMutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> done = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        int strand = i % strands;
+        strandList[strand]->Post([&, strand, i]()
+        {
+            seen[strand].push_back(i);
+            {
+                std::lock_guard<std::mutex> lock(threadMutex);
+                threads.insert(std::this_thread::get_id());
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            ++done;
+        });
+    }
+    WS_CHECK(WaitFor([&]() { return done == count; }, std::chrono::milliseconds(30000)));
+    WS_CHECK(peak > 1);
+    WS_CHECK(peak <= 4);
+    WS_CHECK(threads.size() > 1);
+    for (auto &values: seen)
+    {
+        for (std::size_t i = 1; i < values.size(); ++i)
+        {
+            WS_CHECK(values[i] > values[i - 1]);
+        }
+    }
+
+    // an idle pool retires threads down to minThreads and still accepts work
+    WS_CHECK(WaitFor([&]() { return pool.ThreadCount() == 1; }));
+    std::atomic<bool> ran = false;
+    pool.Post([&ran]() { ran = true; });
+    WS_CHECK(WaitFor([&]() { return ran.load(); }));
+
+    // a strand whose tasks keep posting to it does not starve other work on its loop
+    EventLoopObject host;
+    EventLoop *loop = winSignalTest::WaitForLoop(host);
+    auto strand = Strand::Create(loop);
+    std::atomic<bool> stop = false;
+    std::function<void()> again = [&]()
+    {
+        if (!stop)
+        {
+            strand->Post(again);
+        }
+    };
+    strand->Post(again);
+    std::atomic<bool> other = false;
+    loop->PostEvent([&]() { other = true; });
+    WS_CHECK(WaitFor([&]() { return other.load(); }));
+    stop = true;
+    winSignalTest::RunOn(host, []() {});
+    return winSignalTest::Finish("elastic_pool");
+}
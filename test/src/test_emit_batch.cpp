@@ -0,0 +1,90 @@
+#include <string>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+class Source : public Object
+{
+public:
+    Signal<int, std::string> value;
+    Signal<int> single;
+};
+
+class Sink : public Object
+{
+public:
+    std::vector<int> seen;
+
+    void OnValue(int value, std::string)
+    {
+        seen.push_back(value);
+    }
+};
+
+int main()
+{
+    Host host;
+    WaitForLoop(host);
+    Source source;
+    Sink local, first, second;
+    first.MoveToThread(host.ThreadId());
+    second.MoveToThread(host.ThreadId());
+    Connect(&source, &Source::value, &local, &Sink::OnValue);
+    Connect(&source, &Source::value, &first, &Sink::OnValue);
+    Connect(&source, &Source::value, &second, &Sink::OnValue);
+
+    // a batch keeps range order and stays in order with surrounding emits, for direct and queued slots
+    std::vector<std::tuple<int, std::string>> items;
+    for (int i = 0; i < 500; ++i)
+    {
+        items.emplace_back(i, "item");
+    }
+    source.value.Emit(-1, "before");
+    source.value.EmitBatch(items);
+    source.value.EmitBatch(items.end(), items.end());
+    source.value.Emit(-2, "after");
+
+    std::vector<int> seenFirst, seenSecond;
+    WS_CHECK(WaitFor([&]()
+    {
+        RunOn(host, [&]()
+        {
+            seenFirst = first.seen;
+            seenSecond = second.seen;
+        });
+        return seenFirst.size() == 502 && seenSecond.size() == 502;
+    }));
+    for (auto *seen: { &local.seen, &seenFirst, &seenSecond })
+    {
+        WS_CHECK(seen->size() == 502);
+        if (seen->size() != 502)
+        {
+            continue;
+        }
+        WS_CHECK(seen->front() == -1);
+        WS_CHECK(seen->back() == -2);
+        bool ordered = true;
+        for (int i = 0; i < 500; ++i)
+        {
+            ordered = ordered && (*seen)[i + 1] == i;
+        }
+        WS_CHECK(ordered);
+    }
+
+    // a single argument signal takes a range of plain values
+    std::vector<int> singles;
+    std::atomic<int> queuedSum = 0;
+    Connect(&source, &Source::single, [&singles](int value) { singles.push_back(value); });
+    Connect(&source, &Source::single, &first, [&queuedSum](int value) { queuedSum += value; });
+    source.single.EmitBatch(std::vector<int>{ 1, 2, 3 });
+    WS_CHECK((singles == std::vector<int>{ 1, 2, 3 }));
+    WS_CHECK(WaitFor([&]() { return queuedSum == 6; }));
+    return winSignalTest::Finish("emit_batch");
+}
@@ -0,0 +1,70 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+class Receiver : public Object
+{
+public:
+    std::vector<int> received;
+};
+
+int main()
+{
+    Host host;
+    WaitForLoop(host)->SetFairScheduling(true, 16);
+    Receiver flood, quiet;
+    flood.MoveToThread(host.ThreadId());
+    quiet.MoveToThread(host.ThreadId());
+
+    // a receiver with a deep backlog does not starve one that posts a single event
+    std::atomic<int> floodDone = 0;
+    std::atomic<int> quietAt = -1;
+    std::atomic<bool> release = false;
+    host.InvokeMethod([&release]() { WaitFor([&release]() { return release.load(); }); });
+    for (int i = 0; i < 2000; ++i)
+    {
+        flood.InvokeMethod([&flood, &floodDone, i]()
+        {
+            flood.received.push_back(i);
+            ++floodDone;
+        });
+    }
+    quiet.InvokeMethod([&]() { quietAt = floodDone.load(); });
+    release = true;
+    WS_CHECK(WaitFor([&]() { return floodDone == 2000 && quietAt != -1; }));
+    WS_CHECK(quietAt < 50);
+
+    // each receiver still sees its own events in posting order
+    bool ordered = true;
+    RunOn(host, [&]()
+    {
+        for (int i = 0; i < 2000; ++i)
+        {
+            ordered = ordered && flood.received[i] == i;
+        }
+    });
+    WS_CHECK(ordered);
+
+    // with fair scheduling off the backlog runs first
+    RunOn(host, []() { GetEventLoop(std::this_thread::get_id())->SetFairScheduling(false); });
+    floodDone = 0;
+    quietAt = -1;
+    release = false;
+    host.InvokeMethod([&release]() { WaitFor([&release]() { return release.load(); }); });
+    for (int i = 0; i < 2000; ++i)
+    {
+        flood.InvokeMethod([&floodDone]() { ++floodDone; });
+    }
+    quiet.InvokeMethod([&]() { quietAt = floodDone.load(); });
+    release = true;
+    WS_CHECK(WaitFor([&]() { return quietAt != -1; }));
+    WS_CHECK(quietAt == 2000);
+    return winSignalTest::Finish("fair_scheduling");
+}
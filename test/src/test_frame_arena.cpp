@@ -0,0 +1,73 @@
+#include <string>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+class Source : public Object
+{
+public:
+    Signal<int> changed;
+};
+
+class Sink : public EventLoopObject
+{
+public:
+    std::atomic<int> sum = 0;
+
+    void OnChanged(int count)
+    {
+        std::pmr::vector<int> scratch(FrameResource());
+        for (int i = 0; i < count; ++i)
+        {
+            scratch.push_back(i);
+        }
+        sum += static_cast<int>(scratch.size());
+    }
+};
+
+int main()
+{
+    // threads without a loop use the default resource
+    WS_CHECK(FrameResource() == std::pmr::get_default_resource());
+
+    // loop iterations allocate from their arena, large and repeated requests included
+    Host host;
+    WaitForLoop(host);
+    std::atomic<int> arena = 0;
+    std::atomic<int> intact = 0;
+    for (int i = 0; i < 200; ++i)
+    {
+        host.InvokeMethod([&]()
+        {
+            std::pmr::memory_resource *resource = FrameResource();
+            arena += resource != std::pmr::get_default_resource();
+            std::pmr::vector<char> big(resource);
+            big.resize(100000);
+            big[99999] = 1;
+            std::pmr::string text("frame arena text long enough to leave the small buffer", resource);
+            intact += big[99999] == 1 && text.size() > 16;
+        });
+    }
+    RunOn(host, []() {});
+    WS_CHECK(arena == 200);
+    WS_CHECK(intact == 200);
+
+    // queued slots can use the arena of the loop they run on
+    Sink sink;
+    WaitForLoop(sink);
+    Source source;
+    Connect(&source, &Source::changed, &sink, &Sink::OnChanged, ConnectionType::QueuedConnection);
+    for (int i = 0; i < 100; ++i)
+    {
+        source.changed.Emit(1000);
+    }
+    WS_CHECK(WaitFor([&]() { return sink.sum == 100000; }));
+    return winSignalTest::Finish("frame_arena");
+}
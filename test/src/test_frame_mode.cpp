@@ -0,0 +1,121 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+public:
+    std::atomic<int> value = 0;
+};
+
+class Counter : public Object
+{
+public:
+    int count = 0;
+};
+
+/**
+ * @brief keep the loop over its event budget with slow posts
+ */
+void Flood(EventLoop *loop)
+{
+    for (int i = 0; i < 20; ++i)
+    {
+        loop->PostEvent([]() { std::this_thread::sleep_for(std::chrono::microseconds(300)); });
+    }
+}
+
+int main()
+{
+    Host host;
+    EventLoop *loop = WaitForLoop(host);
+    FrameOptions options;
+    options.period = std::chrono::milliseconds(10);
+    options.eventBudget = std::chrono::milliseconds(1);
+    std::atomic<int> ticks = 0;
+    std::atomic<std::size_t> deferred = 0;
+    loop->SetFrameMode(options, [&](const FrameStats &stats)
+    {
+        ++ticks;
+        deferred += stats.eventsDeferred;
+    });
+    WS_CHECK(WaitFor([&]() { return ticks >= 2; }));
+
+    // blocking sends are never deferred past the budget
+    bool allRan = true;
+    for (int round = 0; round < 20; ++round)
+    {
+        Flood(loop);
+        bool ran = false;
+        loop->SendEvent([&ran]() { ran = true; });
+        allRan = allRan && ran;
+    }
+    WS_CHECK(allRan);
+
+    // plain posts over the budget move to the next frame
+    Flood(loop);
+    WS_CHECK(WaitFor([&]() { return deferred > 0; }));
+
+    // the same for BlockingQueuedConnection and for timers set up through a send
+    Flood(loop);
+    host.InvokeMethod([&host]() { host.value = 1; }, ConnectionType::BlockingQueuedConnection);
+    WS_CHECK(host.value == 1);
+    std::atomic<int> fired = 0;
+    Flood(loop);
+    UINT_PTR timer = loop->SetRepeatTimer(5, [&fired]() { ++fired; });
+    WS_CHECK(WaitFor([&]() { return fired >= 3; }));
+    loop->KillTimer(timer);
+
+    // frames are paced close to the requested period
+    int before = ticks;
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    int paced = ticks - before;
+    WS_CHECK(paced >= 35 && paced <= 55);
+
+    // a send made while the loop sleeps towards a far tick is answered without waiting for it
+    FrameOptions slow = options;
+    slow.period = std::chrono::milliseconds(300);
+    loop->SetFrameMode(slow, [&](const FrameStats &) { ++ticks; });
+    int slowTicks = ticks;
+    WS_CHECK(WaitFor([&]() { return ticks > slowTicks; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto sent = std::chrono::steady_clock::now();
+    loop->SendEvent([]() {});
+    WS_CHECK(std::chrono::steady_clock::now() - sent < std::chrono::milliseconds(100));
+    loop->SetFrameMode(options, [&](const FrameStats &stats)
+    {
+        ++ticks;
+        deferred += stats.eventsDeferred;
+    });
+
+    // ClearFrameMode returns only once the tick callback is gone
+    Flood(loop);
+    loop->ClearFrameMode();
+    int cleared = ticks;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    WS_CHECK(ticks == cleared);
+
+    // shards of a group that runs in frame mode are all created
+    EventLoopGroup group(2);
+    for (std::size_t i = 0; i < group.Size(); ++i)
+    {
+        group.GetEventLoop(i)->SetFrameMode(options, [](const FrameStats &) {});
+        Flood(group.GetEventLoop(i));
+    }
+    {
+        Sharded<Counter> counters(group);
+        std::atomic<int> visited = 0;
+        counters.InvokeOnAll([](Counter &counter) { return ++counter.count; }, [&visited](std::vector<int> results)
+        {
+            visited = static_cast<int>(results.size());
+        });
+        WS_CHECK(WaitFor([&]() { return visited == 2; }));
+    }
+    for (std::size_t i = 0; i < group.Size(); ++i)
+    {
+        group.GetEventLoop(i)->ClearFrameMode();
+    }
+    return winSignalTest::Finish("frame_mode");
+}
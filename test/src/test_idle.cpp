@@ -0,0 +1,42 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+int main()
+{
+    Host host;
+    EventLoop *loop = WaitForLoop(host);
+
+    // idle work repeats while it returns true, a void callable runs once, events still get through
+    std::atomic<int> steps = 0;
+    std::atomic<int> once = 0;
+    std::atomic<int> events = 0;
+    loop->PostIdle([&steps]()
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        return ++steps < 200;
+    });
+    loop->PostIdle([&once]() { ++once; });
+    for (int i = 0; i < 20; ++i)
+    {
+        host.InvokeMethod([&events]() { ++events; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    WS_CHECK(WaitFor([&]() { return steps == 200 && events == 20; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    WS_CHECK(steps == 200);
+    WS_CHECK(once == 1);
+
+    // utilization separates dispatching, idle work and waiting
+    auto utilization = loop->Utilization();
+    WS_CHECK(utilization.idleWork.count() > 0);
+    WS_CHECK(utilization.waiting.count() > 0);
+    WS_CHECK(utilization.IdleUtilization() > 0.0);
+    return winSignalTest::Finish("idle");
+}
@@ -0,0 +1,150 @@
+#include <map>
+#include <mutex>
+#include <string>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+
+struct Feed
+{
+    Signal<std::string, int> update;
+};
+
+int main()
+{
+    const char *symbols[] = { "AAPL", "MSFT", "GOOG", "AMZN", "TSLA", "NVDA" };
+    const int count = 3000;
+
+    // per-key FIFO order holds across a rebalance
+    {
+        EventLoopGroup group(3);
+        Feed feed;
+        std::mutex mutex;
+        std::map<std::string, std::vector<int>> seen;
+        std::atomic<int> received = 0;
+        ConnectByKey(&feed, &Feed::update, &group, KeyArgument<0>(), [&](const std::string &symbol, int sequence)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            seen[symbol].push_back(sequence);
+            ++received;
+        });
+        for (int i = 0; i < count; ++i)
+        {
+            feed.update.Emit(symbols[i % 6], i);
+            if (i == count / 2)
+            {
+                group.AddLoop();
+            }
+        }
+        WS_CHECK(WaitFor([&]() { return received == count; }));
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto &element: seen)
+        {
+            for (std::size_t i = 1; i < element.second.size(); ++i)
+            {
+                WS_CHECK(element.second[i] > element.second[i - 1]);
+            }
+        }
+        WS_CHECK(group.Size() == 4);
+    }
+
+    // a loop added while an old loop is busy waits until the old loop has run what was posted before
+    {
+        EventLoopGroup group(1);
+        std::atomic<bool> release = false;
+        std::mutex mutex;
+        std::vector<int> order;
+        group.PostTo(0, [&]() { WaitFor([&]() { return release.load(); }); });
+        std::size_t key = 0;
+        group.PostByHash(key, [&]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(1);
+        });
+        WS_CHECK(group.AddLoop() == 1);
+        while (group.IndexOf(key) != 1)
+        {
+            ++key;
+        }
+        group.PostByHash(key, [&]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(2);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            WS_CHECK(order.empty());
+        }
+        release = true;
+        WS_CHECK(WaitFor([&]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return order.size() == 2;
+        }));
+        std::lock_guard<std::mutex> lock(mutex);
+        WS_CHECK((order == std::vector<int>{ 1, 2 }));
+    }
+
+    // two connections with the same lambda type are both routed and both removed by DisconnectByKey
+    {
+        EventLoopGroup group(2);
+        Feed feed;
+        std::atomic<int> received = 0;
+        auto connect = [&](int weight)
+        {
+            auto slot = [&received, weight](const std::string &, int) { received += weight; };
+            ConnectByKey(&feed, &Feed::update, &group, KeyArgument<0>(), slot);
+            return slot;
+        };
+        auto slot = connect(1);
+        connect(10);
+        WS_CHECK(feed.update.HandlerCount() == 2);
+        feed.update.Emit("AAPL", 1);
+        WS_CHECK(WaitFor([&]() { return received == 11; }));
+        DisconnectByKey(&feed, &Feed::update, &group, slot);
+        WS_CHECK(feed.update.HandlerCount() == 0);
+    }
+
+    // DisconnectByKey stops routing, the signal keeps working
+    {
+        EventLoopGroup group(2);
+        Feed feed;
+        std::atomic<int> received = 0;
+        auto slot = [&](const std::string &, int) { ++received; };
+        ConnectByKey(&feed, &Feed::update, &group, KeyArgument<0>(), slot);
+        feed.update.Emit("AAPL", 1);
+        WS_CHECK(WaitFor([&]() { return received == 1; }));
+        DisconnectByKey(&feed, &Feed::update, &group, slot);
+        WS_CHECK(feed.update.HandlerCount() == 0);
+        feed.update.Emit("AAPL", 2);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        WS_CHECK(received == 1);
+    }
+
+    // a group destroyed before the signal disconnects itself
+    {
+        Feed feed;
+        std::atomic<int> received = 0;
+        {
+            EventLoopGroup group(2);
+            ConnectByKey(&feed, &Feed::update, &group, KeyArgument<0>(), [&](const std::string &, int) { ++received; });
+            feed.update.Emit("MSFT", 1);
+            WS_CHECK(WaitFor([&]() { return received == 1; }));
+        }
+        WS_CHECK(feed.update.HandlerCount() == 0);
+        feed.update.Emit("MSFT", 2);
+        WS_CHECK(received == 1);
+    }
+
+    // a signal destroyed before the group leaves nothing for the group to remove
+    {
+        EventLoopGroup group(2);
+        {
+            Feed feed;
+            ConnectByKey(&feed, &Feed::update, &group, KeyArgument<0>(), [](const std::string &, int) {});
+        }
+    }
+    return winSignalTest::Finish("key_affinity");
+}
@@ -0,0 +1,99 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+int main()
+{
+    Host host;
+    WaitForLoop(host);
+
+    // posts from the loop's own thread run after the current handler, in posting order with queued invokes
+    std::vector<int> order;
+    std::atomic<bool> done = false;
+    host.InvokeMethod([&]()
+    {
+        EventLoop *loop = GetEventLoop(std::this_thread::get_id());
+        loop->PostEvent([&order, &done, loop]()
+        {
+            order.push_back(2);
+            loop->PostEvent([&order, &done]()
+            {
+                order.push_back(4);
+                done = true;
+            });
+        });
+        host.InvokeMethod([&order]() { order.push_back(3); }, ConnectionType::QueuedConnection);
+        order.push_back(1);
+    });
+    WS_CHECK(WaitFor([&]() { return done.load(); }));
+    WS_CHECK((order == std::vector<int>{ 1, 2, 3, 4 }));
+
+    // a post from the loop's own thread does not overtake deadline work it queued before
+    order.clear();
+    done = false;
+    host.InvokeMethod([&]()
+    {
+        EventLoop *loop = GetEventLoop(std::this_thread::get_id());
+        loop->PostEvent(std::chrono::steady_clock::now() + std::chrono::seconds(1), [&order]() { order.push_back(1); });
+        loop->PostEvent([&order, &done]()
+        {
+            order.push_back(2);
+            done = true;
+        });
+    });
+    WS_CHECK(WaitFor([&]() { return done.load(); }));
+    WS_CHECK((order == std::vector<int>{ 1, 2 }));
+
+    // local posts are counted as pending and age into the dispatch lag
+    std::atomic<std::size_t> pending = 0;
+    std::atomic<bool> lagged = false;
+    done = false;
+    host.InvokeMethod([&]()
+    {
+        EventLoop *loop = GetEventLoop(std::this_thread::get_id());
+        for (int i = 0; i < 3; ++i)
+        {
+            loop->PostEvent([]() {});
+        }
+        pending = loop->PendingCount();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        lagged = loop->DispatchLag() >= std::chrono::milliseconds(20);
+        loop->PostEvent([&done]() { done = true; });
+    });
+    WS_CHECK(WaitFor([&]() { return done.load(); }));
+    WS_CHECK(pending >= 3);
+    WS_CHECK(lagged);
+
+    // a post from a timer callback still wakes the loop
+    std::atomic<bool> fromTimer = false;
+    host.InvokeMethod([&fromTimer]()
+    {
+        Timer::SingleShot(5, [&fromTimer]()
+        {
+            GetEventLoop(std::this_thread::get_id())->PostEvent([&fromTimer]() { fromTimer = true; });
+        });
+    });
+    WS_CHECK(WaitFor([&]() { return fromTimer.load(); }));
+
+    // a long chain of self posts completes without starving other threads' posts
+    std::atomic<int> chain = 0;
+    std::atomic<bool> remote = false;
+    std::function<void()> step;
+    step = [&]()
+    {
+        if (++chain < 10000)
+        {
+            GetEventLoop(std::this_thread::get_id())->PostEvent(step);
+        }
+    };
+    host.InvokeMethod(step);
+    host.InvokeMethod([&remote]() { remote = true; });
+    WS_CHECK(WaitFor([&]() { return chain == 10000 && remote; }));
+    return winSignalTest::Finish("local_post");
+}
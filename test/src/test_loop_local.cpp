@@ -0,0 +1,143 @@
+#include <mutex>
+#include <string>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+struct Cache
+{
+    static inline std::atomic<int> alive = 0;
+    int hits = 0;
+    std::thread::id owner = std::this_thread::get_id();
+
+    Cache()
+    {
+        ++alive;
+    }
+
+    Cache(Cache &&other) noexcept : hits(other.hits)
+    {
+        ++alive;
+    }
+
+    ~Cache()
+    {
+        --alive;
+    }
+};
+
+struct Tracer
+{
+    static inline std::mutex mutex;
+    static inline std::vector<std::string> destroyed;
+    std::string name;
+
+    explicit Tracer(std::string name = std::string()) : name(std::move(name))
+    {
+    }
+
+    Tracer(Tracer &&other) noexcept : name(std::move(other.name))
+    {
+        other.name.clear();
+    }
+
+    ~Tracer()
+    {
+        if (!name.empty())
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            destroyed.push_back(name);
+        }
+    }
+};
+
+int main()
+{
+    LoopLocal<Cache> cache;
+    LoopLocal<int> counter([]() { return 100; });
+
+    // every loop owns its own lazily created instance
+    {
+        Host first, second;
+        WaitForLoop(first);
+        WaitForLoop(second);
+        for (int i = 0; i < 10; ++i)
+        {
+            first.InvokeMethod([&]()
+            {
+                ++cache->hits;
+                ++*counter;
+            });
+            second.InvokeMethod([&]() { ++cache->hits; });
+        }
+        RunOn(first, [&]()
+        {
+            WS_CHECK(cache->hits == 10);
+            WS_CHECK(cache->owner == std::this_thread::get_id());
+            WS_CHECK(*counter == 110);
+        });
+        RunOn(second, [&]()
+        {
+            WS_CHECK(cache->hits == 10);
+            WS_CHECK(!counter.HasValue());
+        });
+        WS_CHECK(Cache::alive == 2);
+    }
+    WS_CHECK(WaitFor([]() { return Cache::alive == 0; }));
+
+    // threads without a loop get their own instance
+    cache->hits = 5;
+    WS_CHECK(cache.Get().hits == 5);
+    WS_CHECK(Cache::alive == 1);
+
+    // loop threads finish their shutdown asynchronously, hence the waits below
+    // shutdown destroys instances in reverse order of their creation on that loop
+    {
+        LoopLocal<Tracer> early([]() { return Tracer("early"); });
+        LoopLocal<Tracer> late([]() { return Tracer("late"); });
+        {
+            Host host;
+            WaitForLoop(host);
+            RunOn(host, [&]()
+            {
+                late.Get();
+                early.Get();
+            });
+        }
+        WS_CHECK(WaitFor([]()
+        {
+            std::lock_guard<std::mutex> lock(Tracer::mutex);
+            return Tracer::destroyed.size() == 2;
+        }));
+        std::lock_guard<std::mutex> lock(Tracer::mutex);
+        WS_CHECK((Tracer::destroyed == std::vector<std::string>{ "early", "late" }));
+        Tracer::destroyed.clear();
+    }
+
+    // a reused slot never exposes the previous owner's value and releases it on the loop
+    {
+        Host host;
+        WaitForLoop(host);
+        for (int round = 0; round < 100; ++round)
+        {
+            LoopLocal<Cache> transient;
+            RunOn(host, [&]()
+            {
+                WS_CHECK(!transient.HasValue());
+                transient->hits = round;
+            });
+        }
+        WS_CHECK(Cache::alive <= 2);
+        LoopLocal<int> reused;
+        RunOn(host, [&]() { WS_CHECK(!reused.HasValue()); });
+    }
+    WS_CHECK(WaitFor([]() { return Cache::alive == 1; }));
+    return winSignalTest::Finish("loop_local");
+}
@@ -0,0 +1,79 @@
+#include <numeric>
+#include <random>
+#include <string>
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+int main()
+{
+    // the pool takes its size from the last request made before it starts
+    WS_CHECK(SetParallelWorkerCount(3));
+    Host host;
+    WaitForLoop(host);
+    std::thread::id loopThread = host.ThreadId();
+
+    std::vector<int> data(1000000);
+    std::iota(data.begin(), data.end(), 0);
+    std::vector<long long> doubled(data.size());
+    std::vector<int> shuffled(777777);
+    std::mt19937 random(1);
+    for (auto &value: shuffled)
+    {
+        value = static_cast<int>(random() % 100000);
+    }
+    std::vector<std::string> words;
+    for (char c = 'a'; c <= 't'; ++c)
+    {
+        words.emplace_back(1, c);
+    }
+
+    // every continuation runs on the calling loop
+    std::atomic<int> stages = 0;
+    std::atomic<bool> onLoop = true;
+    long long sum = -1;
+    std::string joined;
+    auto arrive = [&]()
+    {
+        onLoop = onLoop && std::this_thread::get_id() == loopThread;
+        ++stages;
+    };
+    host.InvokeMethod([&]()
+    {
+        ParallelFor(std::size_t(0), data.size(), [&](std::size_t i) { doubled[i] = static_cast<long long>(data[i]) * 2; }, arrive);
+        ParallelReduce(data.begin(), data.end(), 0LL, [](long long a, long long b) { return a + b; }, [&](long long result)
+        {
+            sum = result;
+            arrive();
+        });
+        ParallelSort(shuffled.begin(), shuffled.end(), arrive);
+        ParallelReduce(words.begin(), words.end(), std::string(">"), [](std::string a, const std::string &b) { return a + b; }, [&](std::string result)
+        {
+            joined = result;
+            arrive();
+        });
+        ParallelFor(5, 5, [](int) {}, arrive);
+    });
+    WS_CHECK(WaitFor([&]() { return stages == 5; }, std::chrono::milliseconds(30000)));
+    WS_CHECK(onLoop);
+    WS_CHECK(sum == 999999LL * 1000000 / 2);
+    WS_CHECK(doubled[12345] == 24690);
+    WS_CHECK(std::is_sorted(shuffled.begin(), shuffled.end()));
+    WS_CHECK(joined == ">abcdefghijklmnopqrst");
+
+    // a caller without an event loop still gets its continuation
+    std::atomic<bool> done = false;
+    std::vector<int> small = { 5, 3, 9, 1 };
+    ParallelSort(small.begin(), small.end(), std::greater<>(), [&done]() { done = true; });
+    WS_CHECK(WaitFor([&]() { return done.load(); }));
+    WS_CHECK((small == std::vector<int>{ 9, 5, 3, 1 }));
+    WS_CHECK(Implementation::WorkStealingPool::GetInstance()->Size() == 3);
+    WS_CHECK(!SetParallelWorkerCount(1));
+    return winSignalTest::Finish("parallel");
+}
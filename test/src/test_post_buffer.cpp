@@ -0,0 +1,85 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+public:
+    std::vector<int> received;
+};
+
+int main()
+{
+    Host source, target;
+    WaitForLoop(source);
+    WaitForLoop(target);
+    RunOn(source, []() { GetEventLoop(std::this_thread::get_id())->SetPostBuffering(true, 300); });
+
+    // buffered posts keep their order across threshold flushes and the end-of-iteration flush
+    RunOn(source, [&]()
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            target.InvokeMethod([&target, i]() { target.received.push_back(i); }, ConnectionType::QueuedConnection);
+        }
+    });
+    std::atomic<bool> ordered = false;
+    WS_CHECK(WaitFor([&]()
+    {
+        std::atomic<std::size_t> size = 0;
+        RunOn(target, [&]() { size = target.received.size(); });
+        return size == 1000;
+    }));
+    RunOn(target, [&]()
+    {
+        bool ok = true;
+        for (int i = 0; i < 1000; ++i)
+        {
+            ok = ok && target.received[i] == i;
+        }
+        ordered = ok;
+    });
+    WS_CHECK(ordered);
+
+    // a blocking send flushes what was buffered for its destination first
+    std::atomic<bool> sawBuffered = false;
+    RunOn(source, [&]()
+    {
+        target.received.clear();
+        target.InvokeMethod([&target]() { target.received.push_back(1); }, ConnectionType::QueuedConnection);
+        target.InvokeMethod([&]() { sawBuffered = target.received.size() == 1; }, ConnectionType::BlockingQueuedConnection);
+    });
+    WS_CHECK(sawBuffered);
+
+    // a destination loop that shuts down before the flush only loses the buffered posts
+    std::atomic<EventLoop *> shortLived = nullptr;
+    std::thread worker([&]()
+    {
+        EventLoop loop;
+        shortLived = &loop;
+        loop.Run();
+    });
+    WaitFor([&]() { return shortLived.load() != nullptr && GetEventLoop(worker.get_id()) != nullptr; });
+    std::atomic<bool> buffered = false;
+    std::atomic<bool> gone = false;
+    std::atomic<int> ran = 0;
+    source.InvokeMethod([&]()
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            shortLived.load()->PostEvent([&]() { ++ran; });
+        }
+        buffered = true;
+        WaitFor([&]() { return gone.load(); });
+    });
+    WaitFor([&]() { return buffered.load(); });
+    shortLived.load()->SendEvent([&]() { shortLived.load()->Quit(); });
+    worker.join();
+    gone = true;
+    RunOn(source, []() {});
+    WS_CHECK(ran == 0);
+    return winSignalTest::Finish("post_buffer");
+}
@@ -0,0 +1,68 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Host : public EventLoopObject
+{
+};
+
+class Widget : public Object
+{
+public:
+    std::atomic<int> layouts = 0;
+
+    void Relayout()
+    {
+        ++layouts;
+    }
+};
+
+int main()
+{
+    Host host;
+    EventLoop *loop = WaitForLoop(host);
+    Widget widget;
+    widget.MoveToThread(host.ThreadId());
+
+    // requests made while one is pending coalesce into a single call
+    std::atomic<bool> release = false;
+    host.InvokeMethod([&release]() { WaitFor([&release]() { return release.load(); }); });
+    int accepted = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        accepted += widget.InvokeMethodOnce(&Widget::Relayout);
+    }
+    release = true;
+    WS_CHECK(accepted == 1);
+    RunOn(host, []() {});
+    WS_CHECK(widget.layouts == 1);
+
+    // the same holds when the requests come from the loop thread itself
+    RunOn(host, [&widget]()
+    {
+        for (int i = 0; i < 50; ++i)
+        {
+            widget.InvokeMethodOnce(&Widget::Relayout);
+        }
+    });
+    WS_CHECK(WaitFor([&]() { return widget.layouts == 2; }));
+
+    // once the call ran a new request is accepted again
+    WS_CHECK(widget.InvokeMethodOnce(&Widget::Relayout));
+    WS_CHECK(WaitFor([&]() { return widget.layouts == 3; }));
+
+    // PostOnce coalesces by tag
+    int tag = 0;
+    std::atomic<int> runs = 0;
+    release = false;
+    host.InvokeMethod([&release]() { WaitFor([&release]() { return release.load(); }); });
+    WS_CHECK(loop->PostOnce(&tag, [&runs]() { ++runs; }));
+    WS_CHECK(!loop->PostOnce(&tag, [&runs]() { ++runs; }));
+    release = true;
+    RunOn(host, []() {});
+    WS_CHECK(runs == 1);
+    return winSignalTest::Finish("post_once");
+}
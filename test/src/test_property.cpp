@@ -0,0 +1,114 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Model : public EventLoopObject
+{
+public:
+    Property<int> width{ this, 1 };
+    Property<std::string> name{ this, "a" };
+};
+
+class View : public Object
+{
+public:
+    std::atomic<int> count = 0;
+    std::atomic<int> last = 0;
+
+    void OnWidth(int width)
+    {
+        ++count;
+        last = width;
+    }
+};
+
+int main()
+{
+    // no loop on this thread: changed fires synchronously and only on real changes
+    Property<double> plain;
+    int plainChanges = 0;
+    Connect(&plain, &Property<double>::changed, [&](double) { ++plainChanges; });
+    plain = 1.0;
+    plain = 1.0;
+    plain.Set(2.0);
+    WS_CHECK(plainChanges == 2);
+    WS_CHECK(plain.Get() == 2.0);
+    WS_CHECK(!plain.Set(2.0));
+
+    // writes inside one iteration coalesce into a single notification of the final value
+    Model model;
+    WaitForLoop(model);
+    View view;
+    view.MoveToThread(model.ThreadId());
+    Connect(&model.width, &Property<int>::changed, &view, &View::OnWidth);
+    std::atomic<int> nameChanges = 0;
+    Connect(&model.name, &Property<std::string>::changed, [&](std::string) { ++nameChanges; });
+
+    RunOn(model, [&]()
+    {
+        model.width = 2;
+        model.width = 3;
+        model.width = 3;
+        model.name = "b";
+        model.name = "b";
+    });
+    WS_CHECK(WaitFor([&]() { return view.count == 1 && nameChanges == 1; }));
+    WS_CHECK(view.last == 3);
+    WS_CHECK(model.width.Get() == 3);
+
+    // a change that is reverted within the iteration is not reported
+    RunOn(model, [&]()
+    {
+        model.width = 4;
+        model.width = 3;
+    });
+    RunOn(model, []() {});
+    WS_CHECK(view.count == 1);
+
+    // writes from other threads are marshalled onto the owner's loop
+    std::thread writer([&]()
+    {
+        for (int i = 10; i <= 20; ++i)
+        {
+            model.width = i;
+        }
+    });
+    writer.join();
+    WS_CHECK(WaitFor([&]() { return view.last == 20; }));
+
+    // without an owner loop concurrent writers notify directly and the last notification matches the stored value
+    Property<int> shared;
+    std::atomic<int> lastShared = 0;
+    std::atomic<int> inside = 0;
+    std::atomic<bool> overlapped = false;
+    Connect(&shared, &Property<int>::changed, [&](int value)
+    {
+        if (inside.fetch_add(1) != 0)
+        {
+            overlapped = true;
+        }
+        lastShared = value;
+        inside.fetch_sub(1);
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t)
+    {
+        writers.emplace_back([&, t]()
+        {
+            for (int i = 1; i <= 2000; ++i)
+            {
+                shared = t * 10000 + i;
+            }
+        });
+    }
+    for (auto &thread: writers)
+    {
+        thread.join();
+    }
+    WS_CHECK(!overlapped);
+    WS_CHECK(lastShared == shared.Get());
+    return winSignalTest::Finish("property");
+}
@@ -0,0 +1,81 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+
+class Counter : public Object
+{
+public:
+    int count = 0;
+    int base;
+
+    explicit Counter(int base) : base(base)
+    {
+    }
+};
+
+class Host : public EventLoopObject
+{
+};
+
+int main()
+{
+    EventLoopGroup group(4);
+    Sharded<Counter> counters(group, 10);
+    WS_CHECK(counters.Size() == 4);
+    WS_CHECK(counters.Local() == nullptr);
+
+    // a key always runs on its own shard, on that shard's thread
+    std::atomic<int> misplaced = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        counters.InvokeOnKey(i, [&counters, &misplaced](Counter &counter)
+        {
+            misplaced += counters.Local() != &counter;
+            ++counter.count;
+        });
+    }
+
+    // results are gathered in shard order and handed to the caller's loop
+    Host host;
+    std::atomic<int> total = -1;
+    std::atomic<bool> onCaller = false;
+    host.InvokeMethod([&]()
+    {
+        counters.InvokeOnAll([](Counter &counter) { return counter.count + counter.base; }, [&](std::vector<int> results)
+        {
+            onCaller = GetEventLoop(std::this_thread::get_id()) == host.GetEventLoop();
+            int sum = 0;
+            for (int value: results)
+            {
+                sum += value;
+            }
+            total = sum;
+        });
+    });
+    WS_CHECK(WaitFor([&]() { return total != -1; }));
+    WS_CHECK(total == 1040);
+    WS_CHECK(onCaller);
+    WS_CHECK(misplaced == 0);
+
+    // bool results are written concurrently into separate slots
+    for (int round = 0; round < 100; ++round)
+    {
+        std::atomic<bool> done = false;
+        std::vector<bool> flags;
+        counters.InvokeOnAll([](Counter &counter) { return counter.base == 10; }, [&](std::vector<bool> results)
+        {
+            flags = std::move(results);
+            done = true;
+        });
+        WS_CHECK(WaitFor([&]() { return done.load(); }));
+        WS_CHECK(flags.size() == 4 && flags[0] && flags[1] && flags[2] && flags[3]);
+    }
+
+    // a void callable only signals completion
+    std::atomic<int> visited = 0;
+    std::atomic<bool> finished = false;
+    counters.InvokeOnAll([&](Counter &) { ++visited; }, [&]() { finished = visited == 4; });
+    WS_CHECK(WaitFor([&]() { return finished.load(); }));
+    return winSignalTest::Finish("sharded");
+}
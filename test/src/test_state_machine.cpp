@@ -0,0 +1,109 @@
+#include "test_common.hpp"
+
+#include <stdexcept>
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+enum class PlayerState { Idle, Running, Paused, Count };
+enum class PlayerEvent { Start, Pause, Stop, Count };
+
+constexpr Transition<PlayerState, PlayerEvent> transitions[] = {
+    { PlayerState::Idle, PlayerEvent::Start, PlayerState::Running },
+    { PlayerState::Running, PlayerEvent::Pause, PlayerState::Paused },
+    { PlayerState::Paused, PlayerEvent::Start, PlayerState::Running },
+    { PlayerState::Running, PlayerEvent::Stop, PlayerState::Idle },
+    { PlayerState::Paused, PlayerEvent::Stop, PlayerState::Idle },
+};
+constexpr TransitionTable<PlayerState, PlayerEvent> table(transitions);
+
+static_assert(table.Next(PlayerState::Idle, PlayerEvent::Start) == static_cast<std::size_t>(PlayerState::Running), "table is built at compile time");
+static_assert(!table.Contains(PlayerState::Idle, PlayerEvent::Stop), "missing transitions stay empty");
+
+class Button : public Object
+{
+public:
+    Signal<> clicked;
+    Signal<int> stopped;
+};
+
+class Player : public EventLoopObject
+{
+public:
+    StateMachine<PlayerState, PlayerEvent> machine{ table, PlayerState::Idle, this };
+};
+
+int main()
+{
+    // without an owner the machine runs synchronously on the calling thread
+    StateMachine<PlayerState, PlayerEvent> local(table, PlayerState::Idle);
+    std::vector<std::pair<PlayerState, PlayerState>> changes;
+    int unhandled = 0;
+    Connect(&local, &StateMachine<PlayerState, PlayerEvent>::stateChanged, [&](PlayerState from, PlayerState to) { changes.emplace_back(from, to); });
+    Connect(&local, &StateMachine<PlayerState, PlayerEvent>::unhandled, [&](PlayerState, PlayerEvent) { ++unhandled; });
+    std::vector<int> order;
+    local.OnExit(PlayerState::Idle, [&]() { order.push_back(1); });
+    local.OnEntry(PlayerState::Running, [&]()
+    {
+        order.push_back(2);
+        // raised from an action: queued until the current transition completes
+        local.Fire(PlayerEvent::Pause);
+        order.push_back(3);
+    });
+    local.OnEntry(PlayerState::Paused, [&]() { order.push_back(4); });
+    local.Fire(PlayerEvent::Start);
+    WS_CHECK(local.CurrentState() == PlayerState::Paused);
+    WS_CHECK((order == std::vector<int>{ 1, 2, 3, 4 }));
+    WS_CHECK(changes.size() == 2);
+    local.Fire(PlayerEvent::Pause);
+    WS_CHECK(unhandled == 1);
+    WS_CHECK(local.CurrentState() == PlayerState::Paused);
+
+    // an action that throws leaves the machine usable and drops the events it queued
+    StateMachine<PlayerState, PlayerEvent> throwing(table, PlayerState::Idle);
+    int pausedEntries = 0;
+    throwing.OnEntry(PlayerState::Running, [&]()
+    {
+        throwing.Fire(PlayerEvent::Pause);
+        throw std::runtime_error("entry failed");
+    });
+    throwing.OnEntry(PlayerState::Paused, [&]() { ++pausedEntries; });
+    bool thrown = false;
+    try
+    {
+        throwing.Fire(PlayerEvent::Start);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    WS_CHECK(thrown);
+    WS_CHECK(throwing.CurrentState() == PlayerState::Running);
+    throwing.Fire(PlayerEvent::Stop);
+    WS_CHECK(throwing.CurrentState() == PlayerState::Idle);
+    WS_CHECK(pausedEntries == 0);
+
+    // events from bound signals are processed on the owner's loop in emission order
+    Player player;
+    WaitForLoop(player);
+    Button button;
+    std::atomic<int> entries = 0;
+    std::atomic<bool> onOwner = true;
+    player.machine.OnEntry(PlayerState::Running, [&]()
+    {
+        ++entries;
+        onOwner = onOwner && std::this_thread::get_id() == player.ThreadId();
+    });
+    player.machine.Bind(&button, &Button::clicked, PlayerEvent::Start);
+    player.machine.Bind(&button, &Button::stopped, PlayerEvent::Stop);
+    button.clicked.Emit();
+    button.stopped.Emit(1);
+    button.clicked.Emit();
+    WS_CHECK(WaitFor([&]() { return entries == 2; }));
+    RunOn(player, []() {});
+    WS_CHECK(onOwner);
+    WS_CHECK(player.machine.CurrentState() == PlayerState::Running);
+    return winSignalTest::Finish("state_machine");
+}
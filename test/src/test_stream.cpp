@@ -0,0 +1,128 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::RunOn;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Source
+{
+public:
+    Signal<int> value;
+    Signal<int, double> pair;
+};
+
+class Sink : public EventLoopObject
+{
+public:
+    std::vector<int> values;
+};
+
+int main()
+{
+    Source source;
+    auto stream = FromSignal(&source, &Source::value);
+
+    std::vector<int> mapped;
+    stream.Map([](int v) { return v * 2; }).Filter([](int v) { return v % 4 == 0; }).Subscribe([&](int v) { mapped.push_back(v); });
+    std::vector<std::vector<int>> buffers;
+    stream.Buffer(3).Subscribe([&](const std::vector<int> &v) { buffers.push_back(v); });
+    std::vector<int> sums;
+    stream.Window(2, [](const std::deque<int> &d)
+    {
+        int sum = 0;
+        for (int v: d)
+        {
+            sum += v;
+        }
+        return sum;
+    }).Subscribe([&](int v) { sums.push_back(v); });
+    auto first = FromSignal(&source, &Source::pair).Map([](const std::tuple<int, double> &t) { return std::get<0>(t); });
+    std::vector<std::pair<int, int>> zipped;
+    stream.ZipLatest(first).Subscribe([&](const std::pair<int, int> &z) { zipped.push_back(z); });
+    int merged = 0;
+    stream.Merge(first).Subscribe([&](int) { ++merged; });
+
+    for (int i = 1; i <= 6; ++i)
+    {
+        source.value.Emit(i);
+    }
+    source.pair.Emit(100, 1.0);
+    source.value.Emit(7);
+    WS_CHECK((mapped == std::vector<int>{ 4, 8, 12 }));
+    WS_CHECK(buffers.size() == 2 && buffers[1] == (std::vector<int>{ 4, 5, 6 }));
+    WS_CHECK(sums.size() == 7 && sums.back() == 13);
+    WS_CHECK(zipped.size() == 2 && zipped[0] == std::make_pair(6, 100) && zipped[1] == std::make_pair(7, 100));
+    WS_CHECK(merged == 8);
+
+    // queued values keep push order even when the receiver's own thread pushes while a batch is pending
+    Sink sink;
+    WaitForLoop(sink);
+    stream.Subscribe(&sink, [&](int v) { sink.values.push_back(v); });
+    RunOn(sink, [&]()
+    {
+        std::thread producer([&]()
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                source.value.Emit(i);
+            }
+        });
+        producer.join();
+        source.value.Emit(100);
+    });
+    WS_CHECK(WaitFor([&]() { return sink.values.size() == 101; }));
+    RunOn(sink, [&]()
+    {
+        WS_CHECK(std::is_sorted(sink.values.begin(), sink.values.end()));
+    });
+
+    // values are dropped while the receiver has no loop, delivery resumes once it has one
+    Object orphan;
+    std::thread idle([]() {});
+    orphan.MoveToThread(idle.get_id());
+    std::vector<int> orphanValues;
+    stream.Subscribe(&orphan, [&](int v) { orphanValues.push_back(v); });
+    source.value.Emit(1);
+    source.value.Emit(2);
+    idle.join();
+    orphan.MoveToThread(sink.ThreadId());
+    source.value.Emit(3);
+    RunOn(sink, []() {});
+    RunOn(sink, [&]()
+    {
+        WS_CHECK((orphanValues == std::vector<int>{ 3 }));
+    });
+
+    // a producer that never pauses does not keep the receiver's loop inside one drain
+    std::atomic<bool> stop = false;
+    std::atomic<int> delivered = 0;
+    stream.Subscribe(&sink, [&](int) { ++delivered; });
+    std::thread flood([&]()
+    {
+        while (!stop)
+        {
+            source.value.Emit(0);
+        }
+    });
+    WS_CHECK(WaitFor([&]() { return delivered > 0; }));
+    std::atomic<bool> ran = false;
+    WaitForLoop(sink)->PostEvent([&]() { ran = true; });
+    WS_CHECK(WaitFor([&]() { return ran.load(); }));
+    stop = true;
+    flood.join();
+    RunOn(sink, []() {});
+
+    // dropping every Stream built on a source detaches it from the signal
+    Source detached;
+    {
+        auto scoped = FromSignal(&detached, &Source::value);
+        auto doubled = scoped.Map([](int v) { return v * 2; });
+        WS_CHECK(detached.value.HandlerCount() == 1);
+        scoped = FromSignal(&detached, &Source::pair).Map([](const std::tuple<int, double> &t) { return std::get<0>(t); });
+        WS_CHECK(detached.value.HandlerCount() == 1);
+    }
+    WS_CHECK(detached.value.HandlerCount() == 0);
+    WS_CHECK(detached.pair.HandlerCount() == 0);
+    return winSignalTest::Finish("stream");
+}
@@ -0,0 +1,60 @@
+#include "test_common.hpp"
+
+using namespace winSignal;
+using winSignalTest::WaitFor;
+using winSignalTest::WaitForLoop;
+
+class Receiver : public EventLoopObject
+{
+public:
+    std::atomic<int> count = 0;
+};
+
+int main()
+{
+    TopicRouter<double> router;
+    int single = 0, multi = 0, exact = 0;
+    router.Subscribe("sensor/+/temp", [&](Topic, double) { ++single; });
+    router.Subscribe("robot/#", [&](double) { ++multi; });
+    auto exactId = router.Subscribe("sensor/1/temp", [&]() { ++exact; });
+
+    Topic sensor = router.Intern("sensor/1/temp");
+    Topic arm = router.Intern("robot/arm/x");
+    WS_CHECK(sensor.IsValid() && arm.IsValid());
+    WS_CHECK(router.Intern("sensor/1/temp") == sensor);
+    WS_CHECK(router.TopicName(arm) == "robot/arm/x");
+
+    router.Publish(sensor, 1.0);
+    router.Publish(arm, 2.0);
+    router.Publish(router.Intern("robot"), 2.0);
+    router.Publish("sensor/2/temp", 3.0);
+    router.Publish("other/1/temp", 3.0);
+    WS_CHECK(single == 2);
+    WS_CHECK(multi == 2);
+    WS_CHECK(exact == 1);
+
+    router.Unsubscribe(exactId);
+    router.Publish(sensor, 1.0);
+    WS_CHECK(exact == 1);
+    WS_CHECK(single == 3);
+
+    // subscriptions made after a topic was interned still reach it
+    int late = 0;
+    router.Subscribe("sensor/#", [&]() { ++late; });
+    router.Publish(sensor, 1.0);
+    WS_CHECK(late == 1);
+
+    // queued delivery to a loop, dropped once the receiver is gone
+    auto receiver = new Receiver;
+    WaitForLoop(*receiver);
+    router.Subscribe("x/#", receiver, [receiver](Topic, double) { ++receiver->count; });
+    router.Publish("x/y", 1.0);
+    router.Publish("x/y/z", 1.0);
+    WS_CHECK(WaitFor([&]() { return receiver->count == 2; }));
+    delete receiver;
+    router.Publish("x/y", 1.0);
+
+    WS_CHECK(!router.Intern("a/+").IsValid());
+    WS_CHECK(router.Subscribe("a/#/b", []() {}) == 0);
+    return winSignalTest::Finish("topic_router");
+}
@@ -18,17 +18,28 @@
 #define __WIN_SIGNAL_HPP__
 
 #include <tuple>
+#include <algorithm>
 #include <functional>
 #include <type_traits>
 #include <map>
 #include <mutex>
 #include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 #include <thread>
 #include <queue>
+#include <deque>
+#include <optional>
+#include <chrono>
+#include <array>
 #include <shared_mutex>
+#include <condition_variable>
 #include <memory>
+#include <memory_resource>
 #include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
 #include <Windows.h>
 
 namespace winSignal
@@ -45,10 +56,73 @@ namespace winSignal
     class Object;
     class EventLoopObject;
     class Timer;
+    struct Topic;
 
     template<typename ...Args>
     class Signal;
 
+    template<typename ...Args>
+    class TopicRouter;
+
+    template<typename T>
+    class Property;
+
+    template<typename T>
+    class Computed;
+
+    template<typename T>
+    class Stream;
+
+    enum class DeadlinePolicy
+    {
+        RunLate,
+        DropExpired,
+    };
+
+    struct LoopUtilization
+    {
+        std::chrono::nanoseconds busy{};
+        std::chrono::nanoseconds idleWork{};
+        std::chrono::nanoseconds waiting{};
+
+        double IdleUtilization() const noexcept
+        {
+            auto idle = idleWork + waiting;
+            return idle.count() == 0 ? 0.0 : static_cast<double>(idleWork.count()) / static_cast<double>(idle.count());
+        }
+    };
+
+    struct FrameOptions
+    {
+        std::chrono::nanoseconds period = std::chrono::nanoseconds(1000000000 / 60);
+        std::chrono::nanoseconds eventBudget = std::chrono::nanoseconds(1000000000 / 240);
+        std::chrono::nanoseconds tickBudget = std::chrono::nanoseconds(1000000000 / 120);
+    };
+
+    struct FrameStats
+    {
+        uint64_t frame = 0;
+        std::chrono::nanoseconds lateness{};
+        std::chrono::nanoseconds eventTime{};
+        std::chrono::nanoseconds tickTime{};
+        std::chrono::nanoseconds frameTime{};
+        std::size_t eventsRun = 0;
+        std::size_t eventsDeferred = 0;
+        bool eventOverrun = false;
+        bool tickOverrun = false;
+        bool frameOverrun = false;
+        uint64_t overruns = 0;
+        uint64_t skippedTicks = 0;
+    };
+
+    struct BroadcastResult
+    {
+        std::size_t loops = 0;
+        std::size_t completed = 0;
+        std::chrono::steady_clock::duration latency = std::chrono::steady_clock::duration::zero();
+        bool wouldDeadlock = false;
+    };
+
     class EventLoop;
 
     static EventLoop *GetEventLoop(std::thread::id id = std::this_thread::get_id());
@@ -306,6 +380,10 @@ namespace winSignal::Implementation
             memcpy(&function, &event, sizeof(event));
         }
 
+        constexpr Address(void *target, const ClassFunctionPointer &key) noexcept : object(target), function(key)
+        {
+        }
+
         template<typename ...Args>
         constexpr explicit Address(void(*handler)(Args...)) noexcept
         {
@@ -351,14 +429,33 @@ namespace winSignal::Implementation
 
     static bool ContainReceiver(const Object &object, const Address &address);
 
+    class BroadcastTask;
+
     class EventLoopManager
     {
     private:
+        using LoopList = std::vector<std::pair<std::thread::id, EventLoop *>>;
         std::unordered_map<std::thread::id, EventLoop *> m_EventLoops;
+        std::shared_ptr<const LoopList> m_Snapshot = std::make_shared<const LoopList>();
+        std::atomic<uint64_t> m_Generation = 0;
         std::mutex m_Mutex;
         EventLoopManager() = default;
         ~EventLoopManager() = default;
 
+        void UpdateSnapshot()
+        {
+            m_Snapshot = std::make_shared<const LoopList>(m_EventLoops.begin(), m_EventLoops.end());
+            m_Generation.fetch_add(1, std::memory_order_release);
+        }
+
+        std::shared_ptr<const LoopList> Snapshot()
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            return m_Snapshot;
+        }
+
+        std::size_t PostToAll(const std::shared_ptr<BroadcastTask> &task, bool runLocal);
+
     public:
         EventLoopManager(const EventLoopManager &) = delete;
         EventLoopManager &operator=(const EventLoopManager &) = delete;
@@ -373,6 +470,7 @@ namespace winSignal::Implementation
         {
             std::unique_lock<std::mutex> lock(m_Mutex);
             m_EventLoops.insert(std::make_pair(std::this_thread::get_id(), loop));
+            UpdateSnapshot();
         }
 
         void RemoveEventLoop()
@@ -381,9 +479,15 @@ namespace winSignal::Implementation
             if (m_EventLoops.count(std::this_thread::get_id()))
             {
                 m_EventLoops.erase(std::this_thread::get_id());
+                UpdateSnapshot();
             }
         }
 
+        uint64_t Generation() const noexcept
+        {
+            return m_Generation.load(std::memory_order_acquire);
+        }
+
         EventLoop *GetEventLoop(std::thread::id id)
         {
             std::unique_lock<std::mutex> lock(m_Mutex);
@@ -393,736 +497,5926 @@ namespace winSignal::Implementation
             }
             return nullptr;
         }
+
+        /**
+         * @brief post func to every registered loop
+         * - all loops share one ref-counted task, done receives the time until the last loop finished
+         */
+        std::size_t Broadcast(std::function<void()> func, std::function<void(std::chrono::steady_clock::duration)> done = nullptr);
+
+        /**
+         * @brief post func to every registered loop and block until all of them ran it or timeout expires
+         * - when called from a loop thread that loop runs func inline and the call returns without waiting for the others
+         *   and with wouldDeadlock set, whatever timeout was given - two loops waiting on each other's broadcast would deadlock
+         */
+        BroadcastResult BroadcastAndWait(std::function<void()> func, std::chrono::steady_clock::duration timeout = (std::chrono::steady_clock::duration::max)());
     };
 
-}
-namespace winSignal
-{
-    class EventLoop
+    struct PendingPost
+    {
+        const void *key = nullptr;
+        std::function<void()> func;
+    };
+
+    class PostBuffer
     {
     private:
-        std::mutex m_Mutex;
-        std::deque<std::function<void()>> m_Messages;
-        std::unordered_map<UINT_PTR, std::function<void()>> m_SingleShotTimerProcs;
-        std::unordered_map<UINT_PTR, std::function<void()>> m_RepeatTimerProcs;
-        HWND m_WndHandle{};
-        std::atomic<int> m_TimerIdAutoIncrease = WM_USER;
-        const int m_MsgId = WM_USER + 1001;
-#ifdef UNICODE
-        const std::wstring m_WndClassName = L"ONESDK_InternalMessageWindow";
-#else
-        const std::string m_WndClassName = "ONESDK_InternalMessageWindow";
-#endif // UNICODE
+        std::vector<std::pair<std::thread::id, std::vector<PendingPost>>> m_Buffers;
+        EventLoop *m_Owner = nullptr;
+        std::size_t m_Threshold = 0;
+        int m_Depth = 0;
+        PostBuffer() = default;
+        ~PostBuffer() = default;
 
     public:
-        EventLoop()
+        PostBuffer(const PostBuffer &) = delete;
+        PostBuffer &operator=(const PostBuffer &) = delete;
+
+        static PostBuffer *GetInstance() noexcept
         {
-            CreateInternalWindow();
-            Implementation::EventLoopManager::GetInstance()->AddEventLoop(this);
+            thread_local PostBuffer instance;
+            return &instance;
         }
 
-        ~EventLoop()
+        bool Accepts(const EventLoop *target) const noexcept
         {
-            Implementation::EventLoopManager::GetInstance()->RemoveEventLoop();
+            return m_Owner != nullptr && m_Owner != target;
         }
 
-        bool CreateInternalWindow()
+        void Begin(EventLoop *owner, std::size_t threshold) noexcept
         {
-            WNDCLASSEX wc = { 0 };
-            wc.cbSize = sizeof(wc);
-            wc.lpfnWndProc = WndProc;
-            wc.hInstance = GetModuleHandle(nullptr);
-            wc.lpszClassName = m_WndClassName.c_str();
-            RegisterClassEx(&wc);
-
-            m_WndHandle = CreateWindow(m_WndClassName.c_str(), m_WndClassName.c_str(), WS_OVERLAPPED, 0, 0, 0, 0,
-                HWND_MESSAGE, nullptr, GetModuleHandle(nullptr), nullptr);
-
-            if (m_WndHandle == nullptr)
+            if (m_Depth++ == 0)
             {
-                return false;
+                m_Owner = owner;
+                m_Threshold = threshold;
             }
-
-            ::SetWindowLongPtr(m_WndHandle, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
-            return true;
         }
-        
-        static LRESULT WINAPI WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
+
+        void End()
         {
-            EventLoop* pThis = reinterpret_cast<EventLoop*>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
-            if (pThis && message == pThis->m_MsgId)
-            {
-                pThis->HandlerMessage();
-            }
-            else
+            if (--m_Depth == 0)
             {
-                switch (message)
-                {
-                case WM_NCDESTROY:
-                    ::SetWindowLongPtr(hWnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(nullptr));
-                    ::PostQuitMessage(0);
-                    break;
-                case WM_TIMER:
-                    pThis->HandlerTimer(wParam);
-                    break;
-                }
+                FlushAll();
+                m_Owner = nullptr;
             }
-            return DefWindowProc(hWnd, message, wParam, lParam);
         }
 
-        void HandlerMessage()
+        template<typename Callable>
+        void Add(std::thread::id target, const void *key, Callable &&func)
         {
-            std::deque<std::function<void()>> messages;
+            auto iter = std::find_if(m_Buffers.begin(), m_Buffers.end(), [target](const auto &buffer)
             {
-                std::unique_lock<std::mutex> lock(m_Mutex);
-                messages = m_Messages;
-                m_Messages.clear();
+                return buffer.first == target;
+            });
+            if (iter == m_Buffers.end())
+            {
+                m_Buffers.emplace_back(target, std::vector<PendingPost>());
+                iter = std::prev(m_Buffers.end());
             }
-            while (!messages.empty()) {
-                std::function<void()> func = std::move(messages.front());
-                messages.pop_front();
-                func();
+            iter->second.push_back(PendingPost{ key, std::forward<Callable>(func) });
+            if (iter->second.size() >= m_Threshold)
+            {
+                Flush(target);
             }
         }
 
-        void HandlerTimer(UINT_PTR timerId)
+        void Flush(std::thread::id target);
+
+        void FlushAll();
+    };
+
+    class LoopLocalStorage
+    {
+    public:
+        struct Slot
         {
-            auto iter = m_SingleShotTimerProcs.find(timerId);
-            if (iter != m_SingleShotTimerProcs.end())
-            {
-               iter->second();
-               ::KillTimer(m_WndHandle, timerId);
-               m_SingleShotTimerProcs.erase(iter);
-               return;
-            }
+            std::size_t index = 0;
+            uint64_t generation = 0;
+        };
 
-            iter = m_RepeatTimerProcs.find(timerId);
-            if (iter != m_RepeatTimerProcs.end())
-            {
-                iter->second();
-            }
+    private:
+        struct Entry
+        {
+            uint64_t generation = 0;
+            std::shared_ptr<void> value;
+        };
+
+        std::vector<Entry> m_Values;
+        std::vector<std::size_t> m_Order;
+
+    private:
+        static std::mutex &SlotMutex()
+        {
+            static std::mutex mutex;
+            return mutex;
         }
 
-        template<typename Callable>
-        void SetSingleShotTimer(int interval, Callable&& func)
+        static std::vector<Slot> &FreeSlots()
         {
-            PostEvent([=]() {
-                if (interval == 0)
-                {
-                    func();
-                    return;
-                }
-                auto id = ::SetTimer(m_WndHandle, m_TimerIdAutoIncrease++, interval, nullptr);
-                m_SingleShotTimerProcs[id] = func;
-            });
+            static std::vector<Slot> slots;
+            return slots;
         }
 
-        template<typename Callable>
-        UINT_PTR SetRepeatTimer(int interval, Callable&& func)
+    public:
+        LoopLocalStorage() = default;
+        LoopLocalStorage(const LoopLocalStorage &) = delete;
+        LoopLocalStorage &operator=(const LoopLocalStorage &) = delete;
+
+        ~LoopLocalStorage()
         {
-            SendEvent([=]() {
-                auto id = ::SetTimer(m_WndHandle, m_TimerIdAutoIncrease, interval, nullptr);
-                m_RepeatTimerProcs[id] = func;
-            });
-            return m_TimerIdAutoIncrease++;
+            Clear();
         }
 
-        void KillTimer(UINT_PTR timerId)
+        /**
+         * @brief reserve a slot, indices of destroyed LoopLocals are reused under a new generation
+         */
+        static Slot NewSlot()
         {
-            PostEvent([=]() {
-                auto iter = m_RepeatTimerProcs.find(timerId);
-                if (iter != m_RepeatTimerProcs.end())
-                {
-                    ::KillTimer(m_WndHandle, timerId);
-                    m_RepeatTimerProcs.erase(iter);
-                }
-            });
+            static std::size_t next = 0;
+            std::unique_lock<std::mutex> lock(SlotMutex());
+            auto &slots = FreeSlots();
+            if (slots.empty())
+            {
+                return Slot{ next++, 1 };
+            }
+            Slot slot = slots.back();
+            slots.pop_back();
+            ++slot.generation;
+            return slot;
         }
 
-        template<typename Callable>
-        void PostEvent(Callable &&func)
+        static void FreeSlot(const Slot &slot)
         {
-            std::unique_lock<std::mutex> lock(m_Mutex);
-            m_Messages.push_back(std::forward<Callable>(func));
-            ::PostMessage(m_WndHandle, m_MsgId, NULL, NULL);
+            std::unique_lock<std::mutex> lock(SlotMutex());
+            FreeSlots().push_back(slot);
         }
 
-        template<typename Callable>
-        void SendEvent(Callable &&func)
+        /**
+         * @brief value stored for slot, values of an earlier generation of the index count as empty
+         */
+        void *Get(const Slot &slot) const noexcept
         {
+            if (slot.index >= m_Values.size() || m_Values[slot.index].generation != slot.generation)
             {
-                std::unique_lock<std::mutex> lock(m_Mutex);
-                m_Messages.push_back(std::forward<Callable>(func));
+                return nullptr;
             }
-            ::SendMessage(m_WndHandle, m_MsgId, NULL, NULL);
+            return m_Values[slot.index].value.get();
         }
 
-        void Run()
+        /**
+         * @brief replace the value of slot, the previous value is destroyed after the storage is consistent again
+         */
+        void Set(const Slot &slot, std::shared_ptr<void> value)
         {
-            MSG msg;
-            BOOL bRet;
-            while ((bRet = GetMessage(&msg, NULL, 0, 0)) != 0)
+            if (slot.index >= m_Values.size())
             {
-                if (bRet == -1)
-                {
-                    // handle the error and possibly exit
-                }
-                else
-                {
-                    TranslateMessage(&msg);
-                    DispatchMessage(&msg);
-                }
+                m_Values.resize(slot.index + 1);
+            }
+            Entry &entry = m_Values[slot.index];
+            std::shared_ptr<void> previous = std::move(entry.value);
+            if (previous)
+            {
+                m_Order.erase(std::find(m_Order.begin(), m_Order.end(), slot.index));
             }
+            entry.generation = slot.generation;
+            entry.value = std::move(value);
+            if (entry.value)
+            {
+                m_Order.push_back(slot.index);
+            }
+            previous.reset();
         }
 
-        void Quit()
+        /**
+         * @brief destroy every value in reverse order of creation on this storage
+         */
+        void Clear()
         {
-            if (m_WndHandle)
+            while (!m_Order.empty())
             {
-                ::DestroyWindow(m_WndHandle);
-                m_WndHandle = nullptr;
+                std::size_t index = m_Order.back();
+                m_Order.pop_back();
+                std::shared_ptr<void> value = std::move(m_Values[index].value);
+                value.reset();
             }
         }
+
+        static LoopLocalStorage *&Current() noexcept
+        {
+            thread_local LoopLocalStorage *storage = nullptr;
+            return storage;
+        }
+
+        static LoopLocalStorage &ThreadFallback()
+        {
+            thread_local LoopLocalStorage storage;
+            return storage;
+        }
     };
 
-    class Thread
+    class FrameArena : public std::pmr::memory_resource
     {
     private:
-        std::atomic<std::thread::id> id;
-        std::thread thread;
-    public:
-        Thread(const Thread &other) = delete;
-        Thread &operator=(const Thread &other) = delete;
+        std::vector<unsigned char> m_Buffer;
+        std::optional<std::pmr::monotonic_buffer_resource> m_Resource;
+        std::size_t m_Limit;
+        std::size_t m_Used = 0;
+        std::size_t m_Peak = 0;
+
+    protected:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            m_Used += bytes + alignment;
+            return m_Resource->allocate(bytes, alignment);
+        }
 
-        Thread(Thread &&other) noexcept
+        void do_deallocate(void *, std::size_t, std::size_t) override
         {
-            id = other.id.load();
-            thread = std::move(other.thread);
         }
 
-        Thread &operator=(Thread &&other) noexcept
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
         {
-            id = other.id.load();
-            thread = std::move(other.thread);
-            return *this;
+            return this == &other;
         }
 
-        template<typename Callable, typename ...Args>
-        explicit Thread(Callable &&func, Args &&... args) :thread([&]()
+    public:
+        explicit FrameArena(std::size_t initial = 16 * 1024, std::size_t limit = 1024 * 1024)
+            : m_Buffer(initial), m_Limit(limit)
         {
-            id = std::this_thread::get_id();
-            std::forward<Callable>(func)(std::forward<Args>(args)...);
-        })
+            m_Resource.emplace(m_Buffer.data(), m_Buffer.size(), std::pmr::new_delete_resource());
+        }
+
+        FrameArena(const FrameArena &) = delete;
+        FrameArena &operator=(const FrameArena &) = delete;
+
+        void Reset()
         {
-            while (GetEventLoop(id) == nullptr)
+            if (m_Used == 0)
             {
-                std::this_thread::yield();
+                return;
             }
-            thread.detach();
+            m_Peak = (std::max)(m_Peak, m_Used);
+            m_Used = 0;
+            if (m_Peak > m_Buffer.size() && m_Buffer.size() < m_Limit)
+            {
+                std::size_t size = m_Buffer.size();
+                while (size < m_Peak && size < m_Limit)
+                {
+                    size *= 2;
+                }
+                m_Resource.reset();
+                m_Buffer.assign((std::min)(size, m_Limit), 0);
+                m_Resource.emplace(m_Buffer.data(), m_Buffer.size(), std::pmr::new_delete_resource());
+                return;
+            }
+            m_Resource->release();
         }
 
-        std::thread::id GetID() const
+        std::size_t Capacity() const noexcept
         {
-            return id.load();
+            return m_Buffer.size();
+        }
+
+        static FrameArena *&Current() noexcept
+        {
+            thread_local FrameArena *arena = nullptr;
+            return arena;
         }
     };
 
-    template<typename ...Args>
-    class Signal
+    class CancelableTask
     {
     private:
-        using Address = Implementation::Address;
-        using AddressHash = Implementation::AddressHash;
-        struct Handler
+        enum : int { Pending, Running, Finished, Cancelled };
+        std::atomic<int> m_State = Pending;
+        std::function<void()> m_Func;
+
+    public:
+        template<typename Callable>
+        explicit CancelableTask(Callable &&func) : m_Func(std::forward<Callable>(func))
         {
-            std::thread::id id;
-            std::shared_ptr<Implementation::EventHandlerInterface<Args...>> handler;
+        }
+
+        void Run()
+        {
+            int expected = Pending;
+            if (!m_State.compare_exchange_strong(expected, Running, std::memory_order_acq_rel))
+            {
+                return;
+            }
+            m_Func();
+            m_Func = nullptr;
+            m_State.store(Finished, std::memory_order_release);
+        }
+
+        bool Cancel()
+        {
+            int expected = Pending;
+            if (!m_State.compare_exchange_strong(expected, Cancelled, std::memory_order_acq_rel))
+            {
+                return false;
+            }
+            m_Func = nullptr;
+            return true;
+        }
+
+        bool IsPending() const noexcept
+        {
+            return m_State.load(std::memory_order_acquire) == Pending;
+        }
+
+        bool IsCancelled() const noexcept
+        {
+            return m_State.load(std::memory_order_acquire) == Cancelled;
+        }
+    };
+
+}
+namespace winSignal
+{
+    /**
+     * @brief handle to a posted task that has not run yet
+     * - Cancel marks the task so the loop skips it without searching its queue, the callable is released at once
+     */
+    class TaskHandle
+    {
+    private:
+        std::shared_ptr<Implementation::CancelableTask> m_Task;
+
+    public:
+        TaskHandle() = default;
+
+        explicit TaskHandle(std::shared_ptr<Implementation::CancelableTask> task) : m_Task(std::move(task))
+        {
+        }
+
+        bool Cancel()
+        {
+            return m_Task && m_Task->Cancel();
+        }
+
+        bool IsPending() const noexcept
+        {
+            return m_Task && m_Task->IsPending();
+        }
+
+        bool IsCancelled() const noexcept
+        {
+            return m_Task && m_Task->IsCancelled();
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return m_Task != nullptr;
+        }
+    };
+
+    /**
+     * @brief collects task handles so superseded work can be withdrawn in one call
+     * - handles of tasks that already ran are pruned as new ones are added
+     */
+    class CancellationGroup
+    {
+    private:
+        std::mutex m_Mutex;
+        std::vector<TaskHandle> m_Handles;
+
+    public:
+        void Add(const TaskHandle &handle)
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            if (m_Handles.size() >= 16 && m_Handles.size() == m_Handles.capacity())
+            {
+                m_Handles.erase(std::remove_if(m_Handles.begin(), m_Handles.end(), [](const TaskHandle &item) {
+                    return !item.IsPending();
+                }), m_Handles.end());
+            }
+            m_Handles.push_back(handle);
+        }
+
+        std::size_t Cancel()
+        {
+            std::vector<TaskHandle> handles;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                handles.swap(m_Handles);
+            }
+            std::size_t count = 0;
+            for (auto &handle: handles)
+            {
+                count += handle.Cancel() ? 1 : 0;
+            }
+            return count;
+        }
+    };
+
+    class EventLoop
+    {
+    private:
+        std::mutex m_Mutex;
+        std::deque<std::function<void()>> m_Messages;
+        std::chrono::steady_clock::time_point m_OldestPostTime;
+        std::atomic<std::chrono::steady_clock::rep> m_BatchPostTime = 0;
+        const std::thread::id m_OwnerId = std::this_thread::get_id();
+        std::deque<std::function<void()>> m_LocalMessages;
+        std::atomic<std::size_t> m_LocalCount = 0;
+        std::atomic<std::chrono::steady_clock::rep> m_LocalPostTime = 0;
+        std::atomic<bool> m_SharedPending = false;
+        int m_IterationDepth = 0;
+        bool m_LocalWakeupPending = false;
+        std::unordered_map<UINT_PTR, std::function<void()>> m_SingleShotTimerProcs;
+        std::unordered_map<UINT_PTR, std::function<void()>> m_RepeatTimerProcs;
+        HWND m_WndHandle{};
+        std::atomic<int> m_TimerIdAutoIncrease = WM_USER;
+        const int m_MsgId = WM_USER + 1001;
+#ifdef UNICODE
+        const std::wstring m_WndClassName = L"ONESDK_InternalMessageWindow";
+#else
+        const std::string m_WndClassName = "ONESDK_InternalMessageWindow";
+#endif // UNICODE
+
+        std::atomic<bool> m_PostBuffering = false;
+        bool m_IterationBuffered = false;
+        std::atomic<std::size_t> m_PostBufferThreshold = 64;
+
+        std::unordered_map<const void *, std::deque<std::function<void()>>> m_SubQueues;
+        std::unordered_map<const void *, std::size_t> m_QueueWeights;
+        std::deque<const void *> m_ActiveQueues;
+        std::size_t m_KeyedCount = 0;
+        std::size_t m_FairBudget = 64;
+        std::atomic<bool> m_FairScheduling = false;
+
+        struct DeadlineTask
+        {
+            std::chrono::steady_clock::time_point deadline;
+            uint64_t sequence = 0;
+            std::function<void()> func;
+        };
+
+        struct DeadlineLater
+        {
+            bool operator()(const DeadlineTask &lhs, const DeadlineTask &rhs) const noexcept
+            {
+                return lhs.deadline > rhs.deadline || (lhs.deadline == rhs.deadline && lhs.sequence > rhs.sequence);
+            }
+        };
+
+        std::vector<DeadlineTask> m_DeadlineTasks;
+        uint64_t m_DeadlineSequence = 0;
+        std::atomic<bool> m_HasDeadlineTasks = false;
+        std::atomic<DeadlinePolicy> m_DeadlinePolicy = DeadlinePolicy::RunLate;
+        std::atomic<uint64_t> m_DeadlineMisses = 0;
+        std::atomic<uint64_t> m_DeadlineDrops = 0;
+
+        std::unordered_set<Implementation::Address, Implementation::AddressHash> m_OnceKeys;
+
+        std::deque<std::function<bool()>> m_IdleTasks;
+        std::vector<std::function<bool()>> m_PendingIdleTasks;
+        std::atomic<bool> m_HasPendingIdleTasks = false;
+        std::atomic<int64_t> m_IdleBudget = 1000;
+        std::atomic<int64_t> m_RunStart = 0;
+        std::atomic<int64_t> m_IdleWorkTime = 0;
+        std::atomic<int64_t> m_WaitTime = 0;
+        std::atomic<int64_t> m_WaitStart = 0;
+
+        std::atomic<int64_t> m_SliceBudget = 2000;
+
+        Implementation::LoopLocalStorage m_LocalStorage;
+        Implementation::FrameArena m_FrameArena;
+
+        bool m_FrameMode = false;
+        FrameOptions m_FrameOptions;
+        std::function<void(const FrameStats &)> m_FrameTick;
+        std::function<void(const FrameStats &)> m_FrameFinished;
+        FrameStats m_FrameStats;
+        std::chrono::steady_clock::time_point m_NextTick;
+        std::chrono::steady_clock::time_point m_EventDeadline = (std::chrono::steady_clock::time_point::max)();
+        HANDLE m_FrameTimer = nullptr;
+        std::size_t m_SendsEnd = 0;
+        std::size_t m_TasksRun = 0;
+        std::size_t m_TasksDeferred = 0;
+
+    private:
+        bool IsEmpty() const noexcept
+        {
+            return m_Messages.empty() && m_KeyedCount == 0 && m_DeadlineTasks.empty();
+        }
+
+        void MarkPostTime()
+        {
+            if (IsEmpty())
+            {
+                m_OldestPostTime = std::chrono::steady_clock::now();
+            }
+            m_SharedPending.store(true, std::memory_order_relaxed);
+        }
+
+        void RunDeadlineTasks()
+        {
+            std::pmr::vector<DeadlineTask> tasks(&m_FrameArena);
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                while (!m_DeadlineTasks.empty())
+                {
+                    std::pop_heap(m_DeadlineTasks.begin(), m_DeadlineTasks.end(), DeadlineLater());
+                    tasks.push_back(std::move(m_DeadlineTasks.back()));
+                    m_DeadlineTasks.pop_back();
+                }
+                m_HasDeadlineTasks.store(false, std::memory_order_relaxed);
+                m_SharedPending.store(!IsEmpty(), std::memory_order_relaxed);
+            }
+            for (auto &task: tasks)
+            {
+                if (std::chrono::steady_clock::now() > task.deadline)
+                {
+                    m_DeadlineMisses.fetch_add(1, std::memory_order_relaxed);
+                    if (m_DeadlinePolicy.load(std::memory_order_relaxed) == DeadlinePolicy::DropExpired)
+                    {
+                        m_DeadlineDrops.fetch_add(1, std::memory_order_relaxed);
+                        continue;
+                    }
+                }
+                task.func();
+            }
+        }
+
+        template<typename Callable>
+        void PostLocal(Callable &&func)
+        {
+            if (m_LocalMessages.empty())
+            {
+                m_LocalPostTime.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+            }
+            m_LocalMessages.push_back(std::forward<Callable>(func));
+            m_LocalCount.fetch_add(1, std::memory_order_relaxed);
+            if (m_IterationDepth == 0 && !m_LocalWakeupPending)
+            {
+                m_LocalWakeupPending = true;
+                ::PostMessage(m_WndHandle, m_MsgId, NULL, NULL);
+            }
+        }
+
+        void RunLocalMessages()
+        {
+            if (m_LocalMessages.empty())
+            {
+                return;
+            }
+            std::deque<std::function<void()>> messages;
+            messages.swap(m_LocalMessages);
+            auto postTime = m_LocalPostTime.exchange(0, std::memory_order_relaxed);
+            auto batchTime = m_BatchPostTime.load(std::memory_order_relaxed);
+            if (batchTime == 0)
+            {
+                m_BatchPostTime.store(postTime, std::memory_order_relaxed);
+            }
+            while (!messages.empty())
+            {
+                std::function<void()> func = std::move(messages.front());
+                messages.pop_front();
+                m_LocalCount.fetch_sub(1, std::memory_order_relaxed);
+                func();
+            }
+            m_BatchPostTime.store(batchTime, std::memory_order_relaxed);
+        }
+
+        static int64_t Nanoseconds(std::chrono::steady_clock::time_point time) noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        }
+
+        bool HasIdleTasks() const noexcept
+        {
+            return !m_IdleTasks.empty() || m_HasPendingIdleTasks.load(std::memory_order_relaxed);
+        }
+
+        void RunIdleSlice()
+        {
+            auto start = std::chrono::steady_clock::now();
+            if (m_HasPendingIdleTasks.load(std::memory_order_relaxed))
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                for (auto &task: m_PendingIdleTasks)
+                {
+                    m_IdleTasks.push_back(std::move(task));
+                }
+                m_PendingIdleTasks.clear();
+                m_HasPendingIdleTasks.store(false, std::memory_order_relaxed);
+            }
+            auto deadline = start + std::chrono::microseconds(m_IdleBudget.load(std::memory_order_relaxed));
+            BeginIteration();
+            while (!m_IdleTasks.empty())
+            {
+                std::function<bool()> task = std::move(m_IdleTasks.front());
+                m_IdleTasks.pop_front();
+                if (task())
+                {
+                    m_IdleTasks.push_back(std::move(task));
+                }
+                if (std::chrono::steady_clock::now() >= deadline || HIWORD(::GetQueueStatus(QS_ALLINPUT)) != 0)
+                {
+                    break;
+                }
+            }
+            EndIteration();
+            ResetFrameArena();
+            m_IdleWorkTime.fetch_add(Nanoseconds(std::chrono::steady_clock::now()) - Nanoseconds(start), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief wait for the next tick on a waitable timer while still answering sent messages
+         * - posted messages wake the wait once, after that only sent messages do until the timer fires
+         */
+        void SleepUntil(std::chrono::steady_clock::time_point target)
+        {
+            auto start = std::chrono::steady_clock::now();
+            if (start >= target)
+            {
+                return;
+            }
+            if (m_FrameTimer == nullptr)
+            {
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+                m_FrameTimer = ::CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+                if (m_FrameTimer == nullptr)
+                {
+                    m_FrameTimer = ::CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+                }
+            }
+            LARGE_INTEGER due;
+            due.QuadPart = -std::chrono::duration_cast<std::chrono::duration<int64_t, std::ratio<1, 10000000>>>(target - start).count();
+            bool timer = m_FrameTimer != nullptr && ::SetWaitableTimer(m_FrameTimer, &due, 0, nullptr, nullptr, FALSE);
+            DWORD wakeMask = QS_ALLINPUT;
+            for (auto now = start; now < target; now = std::chrono::steady_clock::now())
+            {
+                DWORD result;
+                if (timer)
+                {
+                    result = ::MsgWaitForMultipleObjectsEx(1, &m_FrameTimer, INFINITE, wakeMask, MWMO_INPUTAVAILABLE);
+                }
+                else
+                {
+                    auto remaining = std::chrono::ceil<std::chrono::milliseconds>(target - now).count();
+                    result = ::MsgWaitForMultipleObjectsEx(0, nullptr, static_cast<DWORD>(remaining), wakeMask, MWMO_INPUTAVAILABLE);
+                }
+                if (timer && result == WAIT_OBJECT_0)
+                {
+                    break;
+                }
+                if (result == WAIT_OBJECT_0 + (timer ? 1 : 0))
+                {
+                    MSG msg;
+                    ::PeekMessage(&msg, NULL, 0, 0, PM_NOREMOVE | PM_QS_SENDMESSAGE);
+                    if (HIWORD(::GetQueueStatus(QS_ALLINPUT & ~QS_SENDMESSAGE)) != 0)
+                    {
+                        wakeMask = QS_SENDMESSAGE;
+                    }
+                }
+                else if (result != WAIT_TIMEOUT)
+                {
+                    break;
+                }
+            }
+            m_WaitTime.fetch_add(Nanoseconds(std::chrono::steady_clock::now()) - Nanoseconds(start), std::memory_order_relaxed);
+        }
+
+        bool RunFrame()
+        {
+            using Clock = std::chrono::steady_clock;
+            FrameStats &stats = m_FrameStats;
+            Clock::time_point frameStart = Clock::now();
+            stats.lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(frameStart - m_NextTick);
+
+            m_TasksRun = 0;
+            m_TasksDeferred = 0;
+            m_EventDeadline = frameStart + m_FrameOptions.eventBudget;
+            MSG msg;
+            bool running = true;
+            while (Clock::now() < m_EventDeadline && ::PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+            {
+                if (msg.message == WM_QUIT)
+                {
+                    running = false;
+                    break;
+                }
+                TranslateMessage(&msg);
+                DispatchMessage(&msg);
+            }
+            m_EventDeadline = (Clock::time_point::max)();
+            if (!running)
+            {
+                return false;
+            }
+            if (!m_FrameMode)
+            {
+                return true;
+            }
+
+            Clock::time_point tickStart = Clock::now();
+            stats.eventTime = std::chrono::duration_cast<std::chrono::nanoseconds>(tickStart - frameStart);
+            stats.eventsRun = m_TasksRun;
+            stats.eventsDeferred = m_TasksDeferred;
+            stats.eventOverrun = stats.eventTime > m_FrameOptions.eventBudget;
+            if (m_FrameTick)
+            {
+                BeginIteration();
+                m_FrameTick(stats);
+                EndIteration();
+                ResetFrameArena();
+            }
+            Clock::time_point frameEnd = Clock::now();
+            stats.tickTime = std::chrono::duration_cast<std::chrono::nanoseconds>(frameEnd - tickStart);
+            stats.frameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(frameEnd - frameStart);
+            stats.tickOverrun = stats.tickTime > m_FrameOptions.tickBudget;
+            m_NextTick += m_FrameOptions.period;
+            stats.frameOverrun = frameEnd >= m_NextTick;
+            if (stats.frameOverrun)
+            {
+                ++stats.overruns;
+                auto behind = (frameEnd - m_NextTick) / m_FrameOptions.period;
+                stats.skippedTicks += static_cast<uint64_t>(behind);
+                m_NextTick += m_FrameOptions.period * behind;
+            }
+            if (m_FrameFinished)
+            {
+                m_FrameFinished(stats);
+            }
+            ++stats.frame;
+            SleepUntil(m_NextTick);
+            return true;
+        }
+
+        void PushKeyed(const void *key, std::function<void()> &&func)
+        {
+            auto &queue = m_SubQueues[key];
+            if (queue.empty())
+            {
+                m_ActiveQueues.push_back(key);
+            }
+            queue.push_back(std::move(func));
+            ++m_KeyedCount;
+        }
+
+        void TakeFairBatch(std::pmr::vector<std::function<void()>> &batch)
+        {
+            std::size_t budget = m_FairBudget;
+            while (budget > 0 && !m_ActiveQueues.empty())
+            {
+                const void *key = m_ActiveQueues.front();
+                m_ActiveQueues.pop_front();
+                auto iter = m_SubQueues.find(key);
+                auto weight = m_QueueWeights.find(key);
+                std::size_t quantum = weight == m_QueueWeights.end() ? 1 : weight->second;
+                auto &queue = iter->second;
+                for (std::size_t i = 0; i < quantum && budget > 0 && !queue.empty(); ++i, --budget)
+                {
+                    batch.push_back(std::move(queue.front()));
+                    queue.pop_front();
+                    --m_KeyedCount;
+                }
+                if (queue.empty())
+                {
+                    m_SubQueues.erase(iter);
+                }
+                else
+                {
+                    m_ActiveQueues.push_back(key);
+                }
+            }
+        }
+
+    public:
+        EventLoop()
+        {
+            CreateInternalWindow();
+            Implementation::LoopLocalStorage::Current() = &m_LocalStorage;
+            Implementation::FrameArena::Current() = &m_FrameArena;
+            Implementation::EventLoopManager::GetInstance()->AddEventLoop(this);
+        }
+
+        ~EventLoop()
+        {
+            Implementation::EventLoopManager::GetInstance()->RemoveEventLoop();
+            if (m_FrameTimer != nullptr)
+            {
+                ::CloseHandle(m_FrameTimer);
+            }
+            m_LocalStorage.Clear();
+            if (Implementation::LoopLocalStorage::Current() == &m_LocalStorage)
+            {
+                Implementation::LoopLocalStorage::Current() = nullptr;
+            }
+            if (Implementation::FrameArena::Current() == &m_FrameArena)
+            {
+                Implementation::FrameArena::Current() = nullptr;
+            }
+        }
+
+        bool CreateInternalWindow()
+        {
+            WNDCLASSEX wc = { 0 };
+            wc.cbSize = sizeof(wc);
+            wc.lpfnWndProc = WndProc;
+            wc.hInstance = GetModuleHandle(nullptr);
+            wc.lpszClassName = m_WndClassName.c_str();
+            RegisterClassEx(&wc);
+
+            m_WndHandle = CreateWindow(m_WndClassName.c_str(), m_WndClassName.c_str(), WS_OVERLAPPED, 0, 0, 0, 0,
+                HWND_MESSAGE, nullptr, GetModuleHandle(nullptr), nullptr);
+
+            if (m_WndHandle == nullptr)
+            {
+                return false;
+            }
+
+            ::SetWindowLongPtr(m_WndHandle, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+            return true;
+        }
+        
+        static LRESULT WINAPI WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
+        {
+            EventLoop* pThis = reinterpret_cast<EventLoop*>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
+            if (pThis && message == pThis->m_MsgId)
+            {
+                pThis->HandlerMessage();
+                pThis->ResetFrameArena();
+            }
+            else
+            {
+                switch (message)
+                {
+                case WM_NCDESTROY:
+                    ::SetWindowLongPtr(hWnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(nullptr));
+                    ::PostQuitMessage(0);
+                    break;
+                case WM_TIMER:
+                    pThis->HandlerTimer(wParam);
+                    pThis->ResetFrameArena();
+                    break;
+                }
+            }
+            return DefWindowProc(hWnd, message, wParam, lParam);
+        }
+
+        void ResetFrameArena()
+        {
+            if (m_IterationDepth == 0)
+            {
+                m_FrameArena.Reset();
+            }
+        }
+
+        void BeginIteration()
+        {
+            if (m_IterationDepth++ == 0)
+            {
+                m_IterationBuffered = m_PostBuffering.load(std::memory_order_relaxed);
+            }
+            if (m_IterationBuffered)
+            {
+                Implementation::PostBuffer::GetInstance()->Begin(this, m_PostBufferThreshold.load(std::memory_order_relaxed));
+            }
+        }
+
+        void EndIteration()
+        {
+            RunLocalMessages();
+            --m_IterationDepth;
+            if (!m_LocalMessages.empty() && !m_LocalWakeupPending)
+            {
+                m_LocalWakeupPending = true;
+                ::PostMessage(m_WndHandle, m_MsgId, NULL, NULL);
+            }
+            if (m_IterationBuffered)
+            {
+                Implementation::PostBuffer::GetInstance()->End();
+            }
+        }
+
+        void HandlerMessage()
+        {
+            std::deque<std::function<void()>> messages;
+            std::pmr::vector<std::function<void()>> fairBatch(&m_FrameArena);
+            std::size_t sends = 0;
+            bool more = false;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                messages.swap(m_Messages);
+                sends = m_SendsEnd;
+                m_SendsEnd = 0;
+                TakeFairBatch(fairBatch);
+                more = m_KeyedCount != 0;
+                m_SharedPending.store(!IsEmpty(), std::memory_order_relaxed);
+                if (!messages.empty() || !fairBatch.empty())
+                {
+                    m_BatchPostTime.store(m_OldestPostTime.time_since_epoch().count(), std::memory_order_relaxed);
+                }
+                m_OldestPostTime = more || !m_DeadlineTasks.empty() ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+            }
+            m_LocalWakeupPending = false;
+            BeginIteration();
+            RunDeadlineTasks();
+            bool budgeted = m_EventDeadline != (std::chrono::steady_clock::time_point::max)();
+            for (std::size_t index = 0; !messages.empty(); ++index) {
+                if (budgeted && index >= sends && std::chrono::steady_clock::now() >= m_EventDeadline)
+                {
+                    break;
+                }
+                if (m_HasDeadlineTasks.load(std::memory_order_relaxed))
+                {
+                    RunDeadlineTasks();
+                }
+                std::function<void()> func = std::move(messages.front());
+                messages.pop_front();
+                func();
+                ++m_TasksRun;
+            }
+            std::size_t fairIndex = 0;
+            for (; fairIndex < fairBatch.size(); ++fairIndex)
+            {
+                if (budgeted && std::chrono::steady_clock::now() >= m_EventDeadline)
+                {
+                    break;
+                }
+                if (m_HasDeadlineTasks.load(std::memory_order_relaxed))
+                {
+                    RunDeadlineTasks();
+                }
+                fairBatch[fairIndex]();
+                ++m_TasksRun;
+            }
+            if (!messages.empty() || fairIndex < fairBatch.size())
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_TasksDeferred += messages.size() + fairBatch.size() - fairIndex;
+                if (m_SendsEnd != 0)
+                {
+                    m_SendsEnd += messages.size() + fairBatch.size() - fairIndex;
+                }
+                m_Messages.insert(m_Messages.begin(), std::make_move_iterator(fairBatch.begin() + fairIndex), std::make_move_iterator(fairBatch.end()));
+                m_Messages.insert(m_Messages.begin(), std::make_move_iterator(messages.begin()), std::make_move_iterator(messages.end()));
+                // local posts made by this batch are newer than its deferred tasks, they queue behind them
+                m_LocalCount.fetch_sub(m_LocalMessages.size(), std::memory_order_relaxed);
+                m_LocalPostTime.store(0, std::memory_order_relaxed);
+                m_Messages.insert(m_Messages.end(), std::make_move_iterator(m_LocalMessages.begin()), std::make_move_iterator(m_LocalMessages.end()));
+                m_LocalMessages.clear();
+                m_OldestPostTime = std::chrono::steady_clock::now();
+                m_SharedPending.store(true, std::memory_order_relaxed);
+                more = true;
+            }
+            m_BatchPostTime.store(0, std::memory_order_relaxed);
+            EndIteration();
+            if (more)
+            {
+                ::PostMessage(m_WndHandle, m_MsgId, NULL, NULL);
+            }
+        }
+
+        void HandlerTimer(UINT_PTR timerId)
+        {
+            BeginIteration();
+            auto iter = m_SingleShotTimerProcs.find(timerId);
+            if (iter != m_SingleShotTimerProcs.end())
+            {
+               iter->second();
+               ::KillTimer(m_WndHandle, timerId);
+               m_SingleShotTimerProcs.erase(iter);
+               EndIteration();
+               return;
+            }
+
+            iter = m_RepeatTimerProcs.find(timerId);
+            if (iter != m_RepeatTimerProcs.end())
+            {
+                iter->second();
+            }
+            EndIteration();
+        }
+
+        /**
+         * @brief monotonic memory resource released after every handler iteration of this loop
+         * - allocations are a pointer bump, deallocation is a no-op, memory is only valid until the current
+         *   iteration returns, so never store it in anything that outlives the slot or task using it
+         * - the initial block grows to the observed peak so steady state iterations never reach the heap
+         */
+        std::pmr::memory_resource *FrameResource() noexcept
+        {
+            return &m_FrameArena;
+        }
+
+        /**
+         * @brief buffer cross-loop posts made from this loop's iterations
+         * - posts are grouped per destination loop and handed over with one lock and one wakeup
+         *   when the iteration ends or a destination collects threshold events
+         * - destinations are resolved by thread at flush time, posts to a loop that shut down meanwhile are dropped
+         */
+        void SetPostBuffering(bool enable, std::size_t threshold = 64) noexcept
+        {
+            m_PostBufferThreshold.store(threshold == 0 ? 1 : threshold, std::memory_order_relaxed);
+            m_PostBuffering.store(enable, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief serve keyed posts from per-receiver queues in weighted round robin
+         * - at most budget keyed tasks run per iteration, unkeyed posts are still drained in FIFO order
+         */
+        void SetFairScheduling(bool enable, std::size_t budget = 64)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_FairBudget = budget == 0 ? 1 : budget;
+            }
+            m_FairScheduling.store(enable, std::memory_order_relaxed);
+        }
+
+        void SetQueueWeight(const void *key, std::size_t weight)
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            if (weight <= 1)
+            {
+                m_QueueWeights.erase(key);
+            }
+            else
+            {
+                m_QueueWeights[key] = weight;
+            }
+        }
+
+        template<typename Callable>
+        void SetSingleShotTimer(int interval, Callable&& func)
+        {
+            PostEvent([=]() {
+                if (interval == 0)
+                {
+                    func();
+                    return;
+                }
+                auto id = ::SetTimer(m_WndHandle, m_TimerIdAutoIncrease++, interval, nullptr);
+                m_SingleShotTimerProcs[id] = func;
+            });
+        }
+
+        template<typename Callable>
+        UINT_PTR SetRepeatTimer(int interval, Callable&& func)
+        {
+            SendEvent([=]() {
+                auto id = ::SetTimer(m_WndHandle, m_TimerIdAutoIncrease, interval, nullptr);
+                m_RepeatTimerProcs[id] = func;
+            });
+            return m_TimerIdAutoIncrease++;
+        }
+
+        void KillTimer(UINT_PTR timerId)
+        {
+            PostEvent([=]() {
+                auto iter = m_RepeatTimerProcs.find(timerId);
+                if (iter != m_RepeatTimerProcs.end())
+                {
+                    ::KillTimer(m_WndHandle, timerId);
+                    m_RepeatTimerProcs.erase(iter);
+                }
+            });
+        }
+
+        std::size_t PendingCount()
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            return m_Messages.size() + m_KeyedCount + m_DeadlineTasks.size() + m_LocalCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief age of the oldest post that has not finished running
+         * - includes the batch the loop is running right now and posts made from the loop's own thread
+         */
+        std::chrono::steady_clock::duration DispatchLag()
+        {
+            auto now = std::chrono::steady_clock::now();
+            auto age = [now](std::chrono::steady_clock::rep time) {
+                return time == 0 ? std::chrono::steady_clock::duration::zero()
+                    : now - std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(time));
+            };
+            auto lag = (std::max)(age(m_BatchPostTime.load(std::memory_order_relaxed)), age(m_LocalPostTime.load(std::memory_order_relaxed)));
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            if (IsEmpty())
+            {
+                return lag;
+            }
+            return (std::max)(lag, now - m_OldestPostTime);
+        }
+
+        /**
+         * @brief queue func on this loop
+         * - posts made from the loop's own thread skip the lock and the wakeup, they run at the end of the current iteration;
+         *   while shared, keyed or deadline work is queued they take the shared queue so they never overtake it
+         */
+        template<typename Callable>
+        void PostEvent(Callable &&func)
+        {
+            if (std::this_thread::get_id() == m_OwnerId && !m_SharedPending.load(std::memory_order_relaxed))
+            {
+                PostLocal(std::forward<Callable>(func));
+                return;
+            }
+            auto buffer = Implementation::PostBuffer::GetInstance();
+            if (buffer->Accepts(this))
+            {
+                buffer->Add(m_OwnerId, nullptr, std::forward<Callable>(func));
+                return;
+            }
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            MarkPostTime();
+            m_Messages.push_back(std::forward<Callable>(func));
+            ::PostMessage(m_WndHandle, m_MsgId, NULL, NULL);
+        }
+
+        template<typename Callable>
+        void PostEvent(const void *key, Callable &&func)
+        {
+            if (key == nullptr || !m_FairScheduling.load(std::memory_order_relaxed))
+            {
+                PostEvent(std::forward<Callable>(func));
+                return;
+            }
+            auto buffer = Implementation::PostBuffer::GetInstance();
+            if (buffer->Accepts(this))
+            {
+                buffer->Add(m_OwnerId, key, std::forward<Callable>(func));
+                return;
+            }
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            MarkPostTime();
+            PushKeyed(key, std::forward<Callable>(func));
+            ::PostMessage(m_WndHandle, m_MsgId, NULL, NULL);
+        }
+
+        template<typename Callable>
+        void PostEvent(std::chrono::steady_clock::time_point deadline, Callable &&func)
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            MarkPostTime();
+            m_DeadlineTasks.push_back(DeadlineTask{ deadline, m_DeadlineSequence++, std::forward<Callable>(func) });
+            std::push_heap(m_DeadlineTasks.begin(), m_DeadlineTasks.end(), DeadlineLater());
+            m_HasDeadlineTasks.store(true, std::memory_order_relaxed);
+            ::PostMessage(m_WndHandle, m_MsgId, NULL, NULL);
+        }
+
+        /**
+         * @brief post a task that can be withdrawn through the returned handle until it starts
+         */
+        template<typename Callable>
+        TaskHandle PostCancelable(Callable &&func, const void *key = nullptr)
+        {
+            auto task = std::make_shared<Implementation::CancelableTask>(std::forward<Callable>(func));
+            PostEvent(key, [task]() {
+                task->Run();
+            });
+            return TaskHandle(task);
+        }
+
+        template<typename Callable>
+        TaskHandle PostDelayed(int interval, Callable &&func)
+        {
+            auto task = std::make_shared<Implementation::CancelableTask>(std::forward<Callable>(func));
+            SetSingleShotTimer(interval, [task]() {
+                task->Run();
+            });
+            return TaskHandle(task);
+        }
+
+        /**
+         * @brief post func unless a task with the same key is still pending
+         * - the key is released right before func runs, so func may schedule itself again
+         */
+        template<typename Callable>
+        bool PostOnce(const Implementation::Address &key, Callable &&func, const void *receiver = nullptr)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                if (!m_OnceKeys.insert(key).second)
+                {
+                    return false;
+                }
+            }
+            PostEvent(receiver, [this, key, func = std::forward<Callable>(func)]() mutable
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    m_OnceKeys.erase(key);
+                }
+                func();
+            });
+            return true;
+        }
+
+        template<typename Callable>
+        bool PostOnce(const void *key, Callable &&func)
+        {
+            return PostOnce(Implementation::Address(const_cast<void *>(key), Implementation::ClassFunctionPointer()), std::forward<Callable>(func));
+        }
+
+        template<typename T, typename U>
+        bool PostOnce(T *object, void(U::* method)(), const void *receiver = nullptr)
+        {
+            return PostOnce(Implementation::Address(object, method), [object, method]()
+            {
+                (object->*method)();
+            }, receiver);
+        }
+
+        /**
+         * @brief run func only while the loop has no pending events or due timers
+         * - a func returning bool is called again in later slices until it returns false
+         * - each idle slice lasts at most the idle budget and ends early when new events arrive
+         */
+        template<typename Callable>
+        void PostIdle(Callable &&func)
+        {
+            std::function<bool()> task;
+            if constexpr (std::is_same_v<std::invoke_result_t<std::decay_t<Callable> &>, bool>)
+            {
+                task = std::forward<Callable>(func);
+            }
+            else
+            {
+                task = [func = std::forward<Callable>(func)]() mutable
+                {
+                    func();
+                    return false;
+                };
+            }
+            if (std::this_thread::get_id() == m_OwnerId)
+            {
+                m_IdleTasks.push_back(std::move(task));
+                return;
+            }
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_PendingIdleTasks.push_back(std::move(task));
+                m_HasPendingIdleTasks.store(true, std::memory_order_relaxed);
+            }
+            ::PostMessage(m_WndHandle, m_MsgId, NULL, NULL);
+        }
+
+        void SetIdleBudget(std::chrono::microseconds budget) noexcept
+        {
+            m_IdleBudget.store(budget.count() <= 0 ? 1 : budget.count(), std::memory_order_relaxed);
+        }
+
+        LoopUtilization Utilization() const noexcept
+        {
+            LoopUtilization utilization;
+            int64_t start = m_RunStart.load(std::memory_order_relaxed);
+            if (start == 0)
+            {
+                return utilization;
+            }
+            int64_t now = Nanoseconds(std::chrono::steady_clock::now());
+            int64_t total = now - start;
+            int64_t waitStart = m_WaitStart.load(std::memory_order_relaxed);
+            int64_t waiting = m_WaitTime.load(std::memory_order_relaxed) + (waitStart == 0 ? 0 : now - waitStart);
+            utilization.idleWork = std::chrono::nanoseconds(m_IdleWorkTime.load(std::memory_order_relaxed));
+            utilization.waiting = std::chrono::nanoseconds(waiting);
+            utilization.busy = (std::max)(std::chrono::nanoseconds(total) - utilization.idleWork - utilization.waiting, std::chrono::nanoseconds::zero());
+            return utilization;
+        }
+
+        std::thread::id ThreadId() const noexcept
+        {
+            return m_OwnerId;
+        }
+
+        /**
+         * @brief time a cooperative task may run on this loop before it yields
+         */
+        void SetSliceBudget(std::chrono::microseconds budget) noexcept
+        {
+            m_SliceBudget.store(budget.count() <= 0 ? 1 : budget.count(), std::memory_order_relaxed);
+        }
+
+        std::chrono::microseconds SliceBudget() const noexcept
+        {
+            return std::chrono::microseconds(m_SliceBudget.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * @brief dispatch timers that are already due, must be called on the loop thread
+         * - WM_TIMER is only generated for an empty queue, work that keeps re-posting itself calls this to let timers through
+         */
+        void DispatchDueTimers()
+        {
+            MSG msg;
+            while (::PeekMessage(&msg, m_WndHandle, WM_TIMER, WM_TIMER, PM_REMOVE))
+            {
+                DispatchMessage(&msg);
+            }
+        }
+
+        /**
+         * @brief switch the loop to fixed-tick frames
+         * - each frame dispatches queued events until eventBudget is spent, calls tick, then sleeps until the next tick
+         * - events left over when the budget runs out keep their order and run in the following frame,
+         *   blocking sends and everything queued before them always run so SendEvent callers never return early
+         * - a frame that ends after the next tick counts as an overrun, missed ticks are skipped rather than replayed
+         */
+        void SetFrameMode(const FrameOptions &options, std::function<void(const FrameStats &)> tick, std::function<void(const FrameStats &)> finished = nullptr)
+        {
+            PostEvent([this, options, tick = std::move(tick), finished = std::move(finished)]()
+            {
+                m_FrameOptions = options;
+                if (m_FrameOptions.period.count() <= 0)
+                {
+                    m_FrameOptions.period = std::chrono::nanoseconds(1);
+                }
+                m_FrameTick = tick;
+                m_FrameFinished = finished;
+                m_FrameStats = FrameStats();
+                m_NextTick = std::chrono::steady_clock::now();
+                m_FrameMode = true;
+            });
+        }
+
+        /**
+         * @brief leave frame mode, blocks until the loop has dropped its frame callbacks
+         */
+        void ClearFrameMode()
+        {
+            auto clear = [this]()
+            {
+                m_FrameMode = false;
+                m_FrameTick = nullptr;
+                m_FrameFinished = nullptr;
+            };
+            if (std::this_thread::get_id() == m_OwnerId)
+            {
+                clear();
+                return;
+            }
+            SendEvent(clear);
+        }
+
+        void SetDeadlinePolicy(DeadlinePolicy policy) noexcept
+        {
+            m_DeadlinePolicy.store(policy, std::memory_order_relaxed);
+        }
+
+        uint64_t DeadlineMisses() const noexcept
+        {
+            return m_DeadlineMisses.load(std::memory_order_relaxed);
+        }
+
+        uint64_t DeadlineDrops() const noexcept
+        {
+            return m_DeadlineDrops.load(std::memory_order_relaxed);
+        }
+
+        void PostEvents(std::vector<Implementation::PendingPost> &posts)
+        {
+            if (posts.empty())
+            {
+                return;
+            }
+            bool fair = m_FairScheduling.load(std::memory_order_relaxed);
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            MarkPostTime();
+            for (auto &post: posts)
+            {
+                if (fair && post.key != nullptr)
+                {
+                    PushKeyed(post.key, std::move(post.func));
+                }
+                else
+                {
+                    m_Messages.push_back(std::move(post.func));
+                }
+            }
+            posts.clear();
+            ::PostMessage(m_WndHandle, m_MsgId, NULL, NULL);
+        }
+
+        template<typename Callable>
+        void SendEvent(Callable &&func)
+        {
+            auto buffer = Implementation::PostBuffer::GetInstance();
+            if (buffer->Accepts(this))
+            {
+                buffer->Flush(m_OwnerId);
+            }
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                MarkPostTime();
+                m_Messages.push_back(std::forward<Callable>(func));
+                m_SendsEnd = m_Messages.size();
+            }
+            ::SendMessage(m_WndHandle, m_MsgId, NULL, NULL);
+        }
+
+        void Run()
+        {
+            MSG msg;
+            BOOL bRet;
+            m_RunStart.store(Nanoseconds(std::chrono::steady_clock::now()), std::memory_order_relaxed);
+            for (;;)
+            {
+                if (m_FrameMode)
+                {
+                    if (!RunFrame())
+                    {
+                        break;
+                    }
+                    continue;
+                }
+                if (HasIdleTasks())
+                {
+                    if (!::PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+                    {
+                        RunIdleSlice();
+                        continue;
+                    }
+                    bRet = msg.message != WM_QUIT;
+                }
+                else
+                {
+                    int64_t waitStart = Nanoseconds(std::chrono::steady_clock::now());
+                    m_WaitStart.store(waitStart, std::memory_order_relaxed);
+                    bRet = GetMessage(&msg, NULL, 0, 0);
+                    m_WaitTime.fetch_add(Nanoseconds(std::chrono::steady_clock::now()) - waitStart, std::memory_order_relaxed);
+                    m_WaitStart.store(0, std::memory_order_relaxed);
+                }
+                if (bRet == 0)
+                {
+                    break;
+                }
+                if (bRet == -1)
+                {
+                    // handle the error and possibly exit
+                }
+                else
+                {
+                    TranslateMessage(&msg);
+                    DispatchMessage(&msg);
+                }
+            }
+        }
+
+        void Quit()
+        {
+            if (m_WndHandle)
+            {
+                ::DestroyWindow(m_WndHandle);
+                m_WndHandle = nullptr;
+            }
+        }
+    };
+
+    namespace Implementation
+    {
+        inline void PostBuffer::Flush(std::thread::id target)
+        {
+            auto iter = std::find_if(m_Buffers.begin(), m_Buffers.end(), [target](const auto &buffer)
+            {
+                return buffer.first == target;
+            });
+            if (iter == m_Buffers.end())
+            {
+                return;
+            }
+            if (EventLoop *loop = EventLoopManager::GetInstance()->GetEventLoop(target))
+            {
+                loop->PostEvents(iter->second);
+            }
+            iter->second.clear();
+        }
+
+        inline void PostBuffer::FlushAll()
+        {
+            for (auto &buffer: m_Buffers)
+            {
+                if (EventLoop *loop = EventLoopManager::GetInstance()->GetEventLoop(buffer.first))
+                {
+                    loop->PostEvents(buffer.second);
+                }
+            }
+            m_Buffers.clear();
+        }
+
+        class BroadcastTask
+        {
+        private:
+            std::function<void()> m_Func;
+            std::function<void(std::chrono::steady_clock::duration)> m_Done;
+            std::chrono::steady_clock::time_point m_Start = std::chrono::steady_clock::now();
+            std::atomic<std::size_t> m_Remaining = 1;
+            std::size_t m_Total = 0;
+            std::chrono::steady_clock::duration m_Latency = std::chrono::steady_clock::duration::zero();
+            std::mutex m_Mutex;
+            std::condition_variable m_Finished;
+
+        public:
+            BroadcastTask(std::function<void()> func, std::function<void(std::chrono::steady_clock::duration)> done)
+                : m_Func(std::move(func)), m_Done(std::move(done))
+            {
+            }
+
+            void Expect(std::size_t count)
+            {
+                m_Total = count;
+                m_Remaining.fetch_add(count, std::memory_order_relaxed);
+            }
+
+            void Run()
+            {
+                m_Func();
+                Arrive();
+            }
+
+            void Arrive()
+            {
+                std::chrono::steady_clock::duration latency;
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    latency = std::chrono::steady_clock::now() - m_Start;
+                    m_Latency = latency;
+                    if (m_Remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    {
+                        return;
+                    }
+                }
+                m_Finished.notify_all();
+                if (m_Done)
+                {
+                    m_Done(latency);
+                }
+            }
+
+            BroadcastResult Wait(std::chrono::steady_clock::duration timeout)
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                auto finished = [this]() {
+                    return m_Remaining.load(std::memory_order_acquire) == 0;
+                };
+                if (timeout == (std::chrono::steady_clock::duration::max)())
+                {
+                    m_Finished.wait(lock, finished);
+                }
+                else
+                {
+                    m_Finished.wait_for(lock, timeout, finished);
+                }
+                BroadcastResult result;
+                result.loops = m_Total;
+                result.completed = m_Total - (std::min)(m_Total, m_Remaining.load(std::memory_order_acquire));
+                result.latency = finished() ? m_Latency : std::chrono::steady_clock::now() - m_Start;
+                return result;
+            }
+        };
+
+        inline std::size_t EventLoopManager::PostToAll(const std::shared_ptr<BroadcastTask> &task, bool runLocal)
+        {
+            auto loops = Snapshot();
+            task->Expect(loops->size());
+            EventLoop *local = nullptr;
+            for (auto &entry: *loops)
+            {
+                if (runLocal && entry.first == std::this_thread::get_id())
+                {
+                    local = entry.second;
+                    continue;
+                }
+                entry.second->PostEvent([task]() {
+                    task->Run();
+                });
+            }
+            if (local)
+            {
+                task->Run();
+            }
+            task->Arrive();
+            return loops->size();
+        }
+
+        inline std::size_t EventLoopManager::Broadcast(std::function<void()> func, std::function<void(std::chrono::steady_clock::duration)> done)
+        {
+            return PostToAll(std::make_shared<BroadcastTask>(std::move(func), std::move(done)), false);
+        }
+
+        inline BroadcastResult EventLoopManager::BroadcastAndWait(std::function<void()> func, std::chrono::steady_clock::duration timeout)
+        {
+            auto task = std::make_shared<BroadcastTask>(std::move(func), nullptr);
+            PostToAll(task, true);
+            if (GetEventLoop(std::this_thread::get_id()) != nullptr)
+            {
+                BroadcastResult result = task->Wait(std::chrono::steady_clock::duration::zero());
+                result.wouldDeadlock = true;
+                return result;
+            }
+            return task->Wait(timeout);
+        }
+    }
+
+    class Thread
+    {
+    private:
+        std::atomic<std::thread::id> id;
+        std::thread thread;
+    public:
+        Thread(const Thread &other) = delete;
+        Thread &operator=(const Thread &other) = delete;
+
+        Thread(Thread &&other) noexcept
+        {
+            id = other.id.load();
+            thread = std::move(other.thread);
+        }
+
+        Thread &operator=(Thread &&other) noexcept
+        {
+            id = other.id.load();
+            thread = std::move(other.thread);
+            return *this;
+        }
+
+        template<typename Callable, typename ...Args>
+        explicit Thread(Callable &&func, Args &&... args) :thread([&]()
+        {
+            id = std::this_thread::get_id();
+            std::forward<Callable>(func)(std::forward<Args>(args)...);
+        })
+        {
+            while (GetEventLoop(id) == nullptr)
+            {
+                std::this_thread::yield();
+            }
+            thread.detach();
+        }
+
+        std::thread::id GetID() const
+        {
+            return id.load();
+        }
+    };
+
+    namespace Implementation
+    {
+        struct KeyedPoster
+        {
+            const void *receiver = nullptr;
+
+            template<typename Callable>
+            void operator()(EventLoop *loop, Callable &&func) const
+            {
+                loop->PostEvent(receiver, std::forward<Callable>(func));
+            }
+        };
+
+        struct DeadlinePoster
+        {
+            std::chrono::steady_clock::time_point deadline;
+
+            template<typename Callable>
+            void operator()(EventLoop *loop, Callable &&func) const
+            {
+                loop->PostEvent(deadline, std::forward<Callable>(func));
+            }
+        };
+
+        template<typename Handler, typename Poster, typename ...Args>
+        void DispatchEvent(const std::thread::id &id, ConnectionType type, const std::shared_ptr<Handler> &handler, const Poster &post, const Args &... args)
+        {
+            switch (type)
+            {
+                case ConnectionType::AutoConnection:
+                {
+                    if (id == std::this_thread::get_id())
+                    {
+                        (*handler)(args...);
+                    }
+                    else
+                    {
+                        EventLoop *loop = EventLoopManager::GetInstance()->GetEventLoop(id);
+                        if (loop != nullptr)
+                        {
+                            post(loop, [handler, args...]
+                            {
+                                (*handler)(args...);
+                            });
+                        }
+                    }
+                    break;
+                }
+                case ConnectionType::DirectConnection:
+                {
+                    (*handler)(args...);
+                    break;
+                }
+                case ConnectionType::QueuedConnection:
+                {
+                    EventLoop *loop = EventLoopManager::GetInstance()->GetEventLoop(id);
+                    if (loop != nullptr)
+                    {
+                        post(loop, [handler, args...]
+                        {
+                            (*handler)(args...);
+                        });
+                    }
+                    break;
+                }
+                case ConnectionType::BlockingQueuedConnection:
+                {
+                    EventLoop *loop = EventLoopManager::GetInstance()->GetEventLoop(id);
+                    if (loop != nullptr)
+                    {
+                        loop->SendEvent([handler, args...]
+                        {
+                            (*handler)(args...);
+                        });
+                    }
+                    break;
+                }
+            }
+        }
+
+        /**
+         * @brief signals whose handler lock the current thread holds while it emits
+         * - a nested emit of a held signal reuses that lock instead of taking it again or upgrading it
+         */
+        class EmitScope
+        {
+        private:
+            static std::vector<const void *> &Held()
+            {
+                static thread_local std::vector<const void *> held;
+                return held;
+            }
+
+        public:
+            EmitScope(const EmitScope &) = delete;
+            EmitScope &operator=(const EmitScope &) = delete;
+
+            explicit EmitScope(const void *signal)
+            {
+                Held().push_back(signal);
+            }
+
+            ~EmitScope()
+            {
+                Held().pop_back();
+            }
+
+            static bool Holds(const void *signal)
+            {
+                auto &held = Held();
+                return std::find(held.begin(), held.end(), signal) != held.end();
+            }
+
+            static bool Any()
+            {
+                return !Held().empty();
+            }
+        };
+
+        class SignalAccess
+        {
+        public:
+            template<typename Handler, typename ...Args>
+            static void AddHandler(Signal<Args...> &signal, const Address &address, std::thread::id id, std::shared_ptr<Handler> handler, ConnectionType type)
+            {
+                typename Signal<Args...>::Handler v_handler;
+                v_handler.id = id;
+                v_handler.handler = std::move(handler);
+                v_handler.type = type;
+                signal.AddHandler(address, v_handler);
+            }
+
+            template<typename ...Args>
+            static void RemoveHandler(Signal<Args...> &signal, const Address &address)
+            {
+                signal.RemoveHandler(address);
+            }
+        };
+    }
+
+    template<typename ...Args>
+    class Signal
+    {
+    private:
+        using Address = Implementation::Address;
+        using AddressHash = Implementation::AddressHash;
+        struct Handler
+        {
+            std::thread::id id;
+            std::shared_ptr<Implementation::EventHandlerInterface<Args...>> handler;
+            ConnectionType type{};
+            const void *receiver = nullptr;
+        };
+        using HandlerPointer = std::shared_ptr<Implementation::EventHandlerInterface<Args...>>;
+        struct QueuedGroup
+        {
+            EventLoop *loop = nullptr;
+            const void *receiver = nullptr;
+            std::vector<HandlerPointer> handlers;
+        };
+        struct DispatchPlan
+        {
+            std::thread::id thread;
+            uint64_t generation = 0;
+            uint64_t loopGeneration = 0;
+            std::vector<HandlerPointer> direct;
+            std::vector<QueuedGroup> queued;
+            std::vector<std::pair<EventLoop *, HandlerPointer>> blocking;
+        };
+        static constexpr std::size_t MaxCachedPlans = 8;
+    private:
+        std::unordered_map<Address, Handler, AddressHash> m_Handlers;
+        uint64_t m_Generation = 0;
+        std::vector<std::unique_ptr<DispatchPlan>> m_Plans;
+        mutable std::shared_mutex m_Mutex;
+        std::shared_ptr<WeakFlag> m_weakFlag;
+    private:
+        void AddHandler(const Address &address, const Handler &handler)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_Mutex);
+            if (!m_Handlers.count(address))
+            {
+                m_Handlers.insert(std::make_pair(address, handler));
+                ++m_Generation;
+                m_Plans.clear();
+            }
+        }
+
+        void RemoveHandler(const Address &address)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_Mutex);
+            if (m_Handlers.count(address))
+            {
+                m_Handlers.erase(address);
+                ++m_Generation;
+                m_Plans.clear();
+            }
+        }
+
+        const DispatchPlan *FindPlan(std::thread::id thread) const
+        {
+            uint64_t loopGeneration = Implementation::EventLoopManager::GetInstance()->Generation();
+            for (auto &plan: m_Plans)
+            {
+                if (plan->thread == thread)
+                {
+                    bool valid = plan->generation == m_Generation && plan->loopGeneration == loopGeneration;
+                    return valid ? plan.get() : nullptr;
+                }
+            }
+            return nullptr;
+        }
+
+        void BuildPlan(DispatchPlan *plan, std::thread::id thread) const
+        {
+            auto manager = Implementation::EventLoopManager::GetInstance();
+            plan->thread = thread;
+            plan->generation = m_Generation;
+            plan->loopGeneration = manager->Generation();
+            for (auto &&element: m_Handlers)
+            {
+                const Handler &handler = element.second;
+                bool inline_call = handler.type == ConnectionType::DirectConnection
+                    || (handler.type == ConnectionType::AutoConnection && handler.id == thread);
+                if (inline_call)
+                {
+                    plan->direct.push_back(handler.handler);
+                    continue;
+                }
+                EventLoop *loop = manager->GetEventLoop(handler.id);
+                if (loop == nullptr)
+                {
+                    continue;
+                }
+                if (handler.type == ConnectionType::BlockingQueuedConnection)
+                {
+                    plan->blocking.emplace_back(loop, handler.handler);
+                    continue;
+                }
+                auto iter = std::find_if(plan->queued.begin(), plan->queued.end(), [loop, &handler](const QueuedGroup &group) {
+                    return group.loop == loop && group.receiver == handler.receiver;
+                });
+                if (iter == plan->queued.end())
+                {
+                    plan->queued.push_back(QueuedGroup{ loop, handler.receiver, {} });
+                    iter = std::prev(plan->queued.end());
+                }
+                iter->handlers.push_back(handler.handler);
+            }
+        }
+
+        void CompilePlan(std::thread::id thread)
+        {
+            auto plan = std::make_unique<DispatchPlan>();
+            BuildPlan(plan.get(), thread);
+            auto slot = std::find_if(m_Plans.begin(), m_Plans.end(), [thread](const std::unique_ptr<DispatchPlan> &item) {
+                return item->thread == thread;
+            });
+            if (slot != m_Plans.end())
+            {
+                *slot = std::move(plan);
+                return;
+            }
+            if (m_Plans.size() >= MaxCachedPlans)
+            {
+                m_Plans.erase(m_Plans.begin());
+            }
+            m_Plans.push_back(std::move(plan));
+        }
+
+        /**
+         * @brief dispatch plan of the calling thread, compiled on a miss
+         * - the write lock is only tried, never waited for: another emitter may hold the shared lock while its
+         *   blocking slot waits on this thread's loop, and a nested emit would wait on itself; local is filled instead
+         */
+        const DispatchPlan *AcquirePlan(std::shared_lock<std::shared_mutex> &lock, std::thread::id thread, DispatchPlan &local)
+        {
+            const DispatchPlan *plan = FindPlan(thread);
+            if (plan != nullptr)
+            {
+                return plan;
+            }
+            if (lock.owns_lock())
+            {
+                lock.unlock();
+                {
+                    std::unique_lock<std::shared_mutex> writeLock(m_Mutex, std::try_to_lock);
+                    if (writeLock.owns_lock())
+                    {
+                        CompilePlan(thread);
+                    }
+                }
+                lock.lock();
+                plan = FindPlan(thread);
+                if (plan != nullptr)
+                {
+                    return plan;
+                }
+            }
+            BuildPlan(&local, thread);
+            return &local;
+        }
+
+        static void RunPlan(const DispatchPlan &plan, const Args &... args)
+        {
+            for (auto &handler: plan.direct)
+            {
+                (*handler)(args...);
+            }
+            for (auto &group: plan.queued)
+            {
+                if (group.handlers.size() == 1)
+                {
+                    group.loop->PostEvent(group.receiver, [handler = group.handlers.front(), args...]
+                    {
+                        (*handler)(args...);
+                    });
+                    continue;
+                }
+                group.loop->PostEvent(group.receiver, [handlers = group.handlers, args...]
+                {
+                    for (auto &handler: handlers)
+                    {
+                        (*handler)(args...);
+                    }
+                });
+            }
+            for (auto &blocking: plan.blocking)
+            {
+                blocking.first->SendEvent([handler = blocking.second, args...]
+                {
+                    (*handler)(args...);
+                });
+            }
+        }
+
+        template<typename T, typename U, typename ...SlotArgs>
+        Address ImitationFunctionHelper(T *object, U &&t, void(std::decay_t<U>::* func)(SlotArgs...), ConnectionType type)
+        {
+            constexpr bool is_object_v = Implementation::is_object<T,std::thread::id>::value;
+            Address address = Address(object, func);
+            Handler v_handler;
+            v_handler.id = std::this_thread::get_id();
+            v_handler.handler = std::make_shared<Implementation::EventHandler<void, std::tuple<SlotArgs...>, Args...>>(std::forward<U>(t));
+            v_handler.type = type;
+            if constexpr (is_object_v)
+            {
+                v_handler.id = object->ThreadId();
+                v_handler.receiver = static_cast<const Object *>(object);
+            }
+            AddHandler(address, v_handler);
+            return address;
+        }
+
+        template<typename T, typename U, typename ...SlotArgs>
+        Address ImitationFunctionHelper(T *object, U &&t, void(std::decay_t<U>::* func)(SlotArgs...) const, ConnectionType type)
+        {
+            constexpr bool is_object_v = Implementation::is_object<T,std::thread::id>::value;
+            Address address = Address(object, func);
+            Handler v_handler;
+            v_handler.id = std::this_thread::get_id();
+            v_handler.handler = std::make_shared<Implementation::EventHandler<void, std::tuple<SlotArgs...>, Args...>>(std::forward<U>(t));
+            v_handler.type = type;
+            if constexpr (is_object_v)
+            {
+                v_handler.id = object->ThreadId();
+                v_handler.receiver = static_cast<const Object *>(object);
+            }
+            AddHandler(address, v_handler);
+            return address;
+        }
+
+    public:
+        Signal()
+        {
+            m_weakFlag = std::make_shared<WeakFlag>();
+        }
+        ~Signal()
+        {
+            m_Handlers.clear();
+        }
+
+        std::weak_ptr<WeakFlag> GetWeakFlag()
+        {
+            return std::weak_ptr<WeakFlag>(m_weakFlag);
+        }
+
+        std::size_t HandlerCount() const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            return m_Handlers.size();
+        }
+
+        /**
+         * @brief call or queue every connected slot
+         * - the emitting thread reuses a dispatch plan compiled for it until a connection or a loop changes
+         * - a direct slot may emit the same signal again, the nested emit runs under the outer lock
+         */
+        void Emit(const Args &... args)
+        {
+            std::thread::id current = std::this_thread::get_id();
+            std::shared_lock<std::shared_mutex> lock(m_Mutex, std::defer_lock);
+            if (!Implementation::EmitScope::Holds(this))
+            {
+                lock.lock();
+            }
+            DispatchPlan local;
+            const DispatchPlan *plan = AcquirePlan(lock, current, local);
+            Implementation::EmitScope scope(this);
+            RunPlan(*plan, args...);
+        }
+
+        template<typename Item>
+        static void InvokeItem(const HandlerPointer &handler, const Item &item)
+        {
+            if constexpr (std::conjunction_v<std::bool_constant<sizeof...(Args) == 1>, std::is_convertible<const Item &, std::decay_t<Args>>...>)
+            {
+                (*handler)(item);
+            }
+            else
+            {
+                std::apply([&handler](const auto &... items) {
+                    (*handler)(items...);
+                }, item);
+            }
+        }
+
+        /**
+         * @brief emit once per argument tuple in [first, last), a signal with one argument also takes plain values
+         * - every slot sees the items in range order, each (loop, receiver) pair receives a single post carrying all of them;
+         *   receivers sharing a loop are not merged into one post so each keeps its own order under fair scheduling
+         */
+        template<typename Iterator>
+        void EmitBatch(Iterator first, Iterator last)
+        {
+            if (first == last)
+            {
+                return;
+            }
+            std::thread::id current = std::this_thread::get_id();
+            std::shared_lock<std::shared_mutex> lock(m_Mutex, std::defer_lock);
+            if (!Implementation::EmitScope::Holds(this))
+            {
+                lock.lock();
+            }
+            DispatchPlan local;
+            const DispatchPlan *plan = AcquirePlan(lock, current, local);
+            Implementation::EmitScope scope(this);
+
+            for (auto &handler: plan->direct)
+            {
+                for (auto iter = first; iter != last; ++iter)
+                {
+                    InvokeItem(handler, *iter);
+                }
+            }
+            if (plan->queued.empty() && plan->blocking.empty())
+            {
+                return;
+            }
+
+            auto batch = std::make_shared<const std::vector<std::tuple<Args...>>>(first, last);
+            auto deliver = [batch](const HandlerPointer &handler) {
+                for (auto &item: *batch)
+                {
+                    InvokeItem(handler, item);
+                }
+            };
+            for (auto &group: plan->queued)
+            {
+                group.loop->PostEvent(group.receiver, [handlers = group.handlers, deliver]
+                {
+                    for (auto &handler: handlers)
+                    {
+                        deliver(handler);
+                    }
+                });
+            }
+            for (auto &blocking: plan->blocking)
+            {
+                blocking.first->SendEvent([handler = blocking.second, deliver]
+                {
+                    deliver(handler);
+                });
+            }
+        }
+
+        template<typename Range>
+        void EmitBatch(const Range &items)
+        {
+            EmitBatch(std::begin(items), std::end(items));
+        }
+
+        /**
+         * @brief emit with a soft deadline
+         * - queued deliveries are dispatched earliest deadline first, ahead of untagged work on the target loop
+         */
+        void EmitBefore(std::chrono::steady_clock::time_point deadline, const Args &... args)
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex, std::defer_lock);
+            if (!Implementation::EmitScope::Holds(this))
+            {
+                lock.lock();
+            }
+            Implementation::EmitScope scope(this);
+            for (auto &&element: m_Handlers)
+            {
+                Implementation::DispatchEvent(element.second.id, element.second.type, element.second.handler, Implementation::DeadlinePoster{ deadline }, args...);
+            }
+        }
+
+    public:
+        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...), ConnectionType type);
+
+        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...));
+
+        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...) const, ConnectionType type);
+
+        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...) const);
+
+        template<typename Sender, typename Receiver, typename T, typename Lambda, typename ...SignalArgs>
+        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, Lambda &&lambda, ConnectionType type);
+
+        template<typename Sender, typename T, typename Lambda, typename ...SignalArgs>
+        friend constexpr void Connect(Sender* sender, Signal<SignalArgs...> T::* event, Lambda&& lambda);
+
+        template<typename Sender, typename T, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, void(*handler)(SlotArgs...));
+
+        template<typename Sender, typename T, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, void(*handler)(SlotArgs...));
+
+        friend class Implementation::SignalAccess;
+    };
+
+
+    class WeakFlag
+    {
+
+    };
+
+    class Object
+    {
+    private:
+        using Address = Implementation::Address;
+        using AddressHash = Implementation::AddressHash;
+        using ClassFunctionPointer = Implementation::ClassFunctionPointer;
+        using Connection = std::map<ClassFunctionPointer, std::function<void()>>;
+    private:
+        std::atomic<std::thread::id> m_Id;
+        std::unordered_map<Address, Connection, AddressHash> m_SendersList;
+        std::unordered_map<Address, std::function<void()>, AddressHash> m_ReceiversList;
+        mutable std::shared_mutex m_Mutex;
+        std::shared_ptr<WeakFlag> m_weakFlag;
+    private:
+        template<typename Callable>
+        void AddSender(const Address &senderAddress, const ClassFunctionPointer &functionAddress, Callable &&func)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_Mutex);
+            m_SendersList[senderAddress][functionAddress] = std::forward<Callable>(func);
+        }
+
+        template<typename Callable>
+        void AddReceiver(const Address &receiverAddress, Callable &&func)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_Mutex);
+            m_ReceiversList[receiverAddress] = std::forward<Callable>(func);
+        }
+
+        void RemoveSender(const Address &senderAddress, const ClassFunctionPointer &functionAddress)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_Mutex);
+            m_SendersList.at(senderAddress).erase(functionAddress);
+        }
+
+        void RemoveReceiver(const Address &address)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_Mutex);
+            m_ReceiversList.erase(address);
+        }
+
+        bool ContainSender(const Address &address) const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            return m_SendersList.count(address);
+        }
+
+        bool ContainReceiver(const Address &address) const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            return m_ReceiversList.count(address);
+        }
+
+    public:
+        template<typename Callable>
+        friend void Implementation::AddSender(Object &object, const Address &senderAddress, const ClassFunctionPointer &functionAddress, Callable &&func);
+
+        template<typename Callable>
+        friend void Implementation::AddReceiver(Object &object, const Address &receiverAddress, Callable &&func);
+
+        friend void Implementation::RemoveSender(Object &object, const Address &senderAddress, const ClassFunctionPointer &functionAddress);
+
+        friend void Implementation::RemoveReceiver(Object &object, const Address &address);
+
+        friend bool Implementation::ContainSender(const Object &object, const Address &address);
+
+        friend bool Implementation::ContainReceiver(const Object &object, const Address &address);
+
+        Object()
+        {
+            m_Id = std::this_thread::get_id();
+            m_weakFlag = std::make_shared<WeakFlag>();
+        }
+
+        virtual ~Object()
+        {
+            DisconnectAll();
+        }
+
+        std::weak_ptr<WeakFlag> GetWeakFlag() noexcept
+        {
+            return std::weak_ptr<WeakFlag>(m_weakFlag);
+        }
+
+        void MoveToThread(const std::thread &target) noexcept
+        {
+            m_Id = target.get_id();
+        }
+
+        void MoveToThread(const std::thread::id &id) noexcept
+        {
+            m_Id = id;
+        }
+
+        void MoveToThread(const Thread &other) noexcept
+        {
+            m_Id = other.GetID();
+        }
+
+        std::thread::id ThreadId() const noexcept
+        {
+            return m_Id;
+        }
+
+        winSignal::EventLoop* GetEventLoop() noexcept
+        {
+           return winSignal::GetEventLoop(m_Id);
+        }
+
+        template<typename Callable>
+        void InvokeMethod(Callable&& func, winSignal::ConnectionType type = ConnectionType::AutoConnection)
+        {
+            switch (type)
+            {
+            case ConnectionType::AutoConnection:
+            {
+                if (m_Id == std::this_thread::get_id())
+                {
+                    func();
+                }
+                else if (EventLoop* loop = GetEventLoop())
+                {
+                    loop->PostEvent(this, [=]() {
+                        func();
+                    });
+                }
+                break;
+            }
+            case ConnectionType::DirectConnection:
+            {
+                func();
+                break;
+            }
+            case ConnectionType::QueuedConnection:
+            {
+                if (EventLoop* loop = GetEventLoop())
+                {
+                    loop->PostEvent(this, [=]() {
+                        func();
+                    });
+                }
+                break;
+            }
+            case ConnectionType::BlockingQueuedConnection:
+            {
+                if (EventLoop* loop = GetEventLoop())
+                {
+                    loop->SendEvent([=]() {
+                        func();
+                    });
+                    break;
+                }
+            }
+            }
+        }
+
+        /**
+         * @brief queue func on this object's loop and return a handle that can withdraw it
+         * - an empty handle is returned when the object's thread has no event loop
+         */
+        template<typename Callable>
+        TaskHandle InvokeMethodCancelable(Callable &&func)
+        {
+            if (EventLoop* loop = GetEventLoop())
+            {
+                return loop->PostCancelable(std::forward<Callable>(func), this);
+            }
+            return TaskHandle();
+        }
+
+        template<typename Callable>
+        TaskHandle InvokeMethodDelayed(int interval, Callable &&func)
+        {
+            if (EventLoop* loop = GetEventLoop())
+            {
+                return loop->PostDelayed(interval, std::forward<Callable>(func));
+            }
+            return TaskHandle();
+        }
+
+        /**
+         * @brief queue method on this object's loop unless the same call is already pending there
+         */
+        template<typename U>
+        bool InvokeMethodOnce(void(U::* method)())
+        {
+            if (EventLoop* loop = GetEventLoop())
+            {
+                return loop->PostOnce(static_cast<U *>(this), method, this);
+            }
+            return false;
+        }
+
+        void DisconnectAll()
+        {
+            std::unordered_map<Address, Connection, AddressHash> sendersList;
+            std::unordered_map<Address, std::function<void()>, AddressHash> receiversList;
+            {
+                std::shared_lock<std::shared_mutex> lock(m_Mutex);
+                sendersList = m_SendersList;
+                receiversList = m_ReceiversList;
+            }
+            for (auto& pair : sendersList)
+            {
+                for (auto& func : pair.second)
+                {
+                    func.second();
+                }
+            }
+            for (auto& receiver : receiversList)
+            {
+                (receiver.second)();
+            }
+        }
+
+        void DeleteLater()
+        {
+            DisconnectAll();
+            if (EventLoop* loop = GetEventLoop())
+            {
+                loop->PostEvent(this, [=]() {
+                    delete this;
+                });
+            }
+            else
+            {
+                delete this;
+            }
+        }
+
+        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...), ConnectionType type);
+
+        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...));
+
+        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...) const, ConnectionType type);
+
+        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...) const);
+
+        template<typename Sender, typename Receiver, typename T, typename Lambda, typename ...SignalArgs>
+        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, Lambda &&lambda, ConnectionType type);
+
+        template<typename Sender, typename T, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, void(*handler)(SlotArgs...));
+
+        template<typename Sender, typename T, typename ...SignalArgs, typename ...SlotArgs>
+        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, void(*handler)(SlotArgs...));
+
+    };
+
+    class EventLoopObject : public Object
+    {
+    private:
+        winSignal::Thread* m_pThread = nullptr;
+
+    public:
+        EventLoopObject()
+        {
+            m_pThread = new winSignal::Thread([=]()
+            {
+                winSignal::EventLoop eventLoop;
+                eventLoop.Run();
+            });
+            MoveToThread(*m_pThread);
+        }
+
+        virtual ~EventLoopObject()
+        {
+            if (auto eventLoop = GetEventLoop())
+            {
+                eventLoop->SendEvent([=](){
+                    eventLoop->Quit();
+                });
+            }
+
+            if (m_pThread)
+            {
+                delete m_pThread;
+                m_pThread = nullptr;
+            }
+        }
+    };
+
+    class Timer : public Object
+    {
+    public:
+        ~Timer()
+        {
+            Stop();
+            m_timerId = 0;
+        }
+
+        template<typename Callable>
+        static TaskHandle SingleShot(int interval, Callable&& func)
+        {
+            auto eventLoop = winSignal::GetEventLoop(std::this_thread::get_id());
+            if (eventLoop)
+            {
+                return eventLoop->PostDelayed(interval, std::forward<Callable>(func));
+            }
+            return TaskHandle();
+        }
+
+        template<typename Callable>
+        void Start(int interval, Callable&& func)
+        {
+            if (IsAlive())
+                return;
+
+            auto eventLoop = winSignal::GetEventLoop(std::this_thread::get_id());
+            if (eventLoop)
+            {
+                m_timerId = eventLoop->SetRepeatTimer(interval, std::forward<Callable>(func));
+            }
+        }
+
+        void Start(int interval)
+        {
+            if (IsAlive())
+                return;
+
+            auto eventLoop = winSignal::GetEventLoop(std::this_thread::get_id());
+            if (eventLoop)
+            {
+                m_timerId = eventLoop->SetRepeatTimer(interval, [&]() {
+                    timeout.Emit();
+                });
+            }
+        }
+
+        void Stop()
+        {
+            if (!IsAlive())
+                return;
+
+            auto eventLoop = winSignal::GetEventLoop(std::this_thread::get_id());
+            if (eventLoop)
+            {
+                eventLoop->KillTimer(m_timerId);
+                m_timerId = 0;
+            }
+        }
+
+        bool IsAlive()
+        {
+            return m_timerId > 0;
+        }
+
+    public:
+        winSignal::Signal<> timeout;
+
+    private:
+        UINT_PTR m_timerId = 0;
+    };
+
+    struct Topic
+    {
+        uint32_t id = 0;
+
+        bool IsValid() const noexcept
+        {
+            return id != 0;
+        }
+
+        bool operator==(const Topic &other) const noexcept
+        {
+            return id == other.id;
+        }
+    };
+
+    /**
+     * @brief topic based publish/subscribe on top of Object
+     * - topics are '/' separated levels, subscriptions may use '+' (one level) and '#' (remaining levels)
+     * - Intern() resolves a topic once, Publish(Topic) then only walks the precomputed subscriber list
+     */
+    template<typename ...Args>
+    class TopicRouter : public Object
+    {
+    private:
+        using Address = Implementation::Address;
+        using ClassFunctionPointer = Implementation::ClassFunctionPointer;
+        using HandlerInterface = Implementation::EventHandlerInterface<Topic, Args...>;
+
+        struct Subscriber
+        {
+            std::size_t id = 0;
+            std::thread::id threadId;
+            std::shared_ptr<HandlerInterface> handler;
             ConnectionType type{};
+            std::vector<uint32_t> pattern;
+            Object *receiver = nullptr;
+        };
+
+        struct TrieNode
+        {
+            std::unordered_map<uint32_t, std::unique_ptr<TrieNode>> children;
+            std::vector<std::shared_ptr<Subscriber>> subscribers;
+        };
+
+        struct TopicEntry
+        {
+            std::string name;
+            std::vector<uint32_t> levels;
+            std::vector<std::shared_ptr<Subscriber>> subscribers;
+        };
+
+        constexpr static uint32_t SingleLevelWildcard = 0;
+        constexpr static uint32_t MultiLevelWildcard = 1;
+
+    private:
+        std::unordered_map<std::string, uint32_t> m_Levels{ { "+", SingleLevelWildcard }, { "#", MultiLevelWildcard } };
+        std::unordered_map<std::string, Topic> m_Topics;
+        std::vector<TopicEntry> m_TopicEntries;
+        std::unordered_map<std::size_t, std::shared_ptr<Subscriber>> m_Subscribers;
+        TrieNode m_Root;
+        std::size_t m_SubscriberIdAutoIncrease = 1;
+        mutable std::shared_mutex m_RouterMutex;
+
+    private:
+        static std::vector<std::string> SplitLevels(const std::string &name)
+        {
+            std::vector<std::string> levels;
+            std::size_t begin = 0;
+            while (true)
+            {
+                std::size_t end = name.find('/', begin);
+                levels.push_back(name.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+                if (end == std::string::npos)
+                {
+                    break;
+                }
+                begin = end + 1;
+            }
+            return levels;
+        }
+
+        uint32_t InternLevel(const std::string &level)
+        {
+            auto iter = m_Levels.find(level);
+            if (iter != m_Levels.end())
+            {
+                return iter->second;
+            }
+            auto id = static_cast<uint32_t>(m_Levels.size());
+            m_Levels.insert(std::make_pair(level, id));
+            return id;
+        }
+
+        static bool MatchPattern(const std::vector<uint32_t> &pattern, const std::vector<uint32_t> &levels) noexcept
+        {
+            for (std::size_t i = 0; i < pattern.size(); ++i)
+            {
+                if (pattern[i] == MultiLevelWildcard)
+                {
+                    return true;
+                }
+                if (i >= levels.size() || (pattern[i] != SingleLevelWildcard && pattern[i] != levels[i]))
+                {
+                    return false;
+                }
+            }
+            return pattern.size() == levels.size();
+        }
+
+        static void MatchTrie(const TrieNode &node, const std::vector<uint32_t> &levels, std::size_t depth, std::vector<std::shared_ptr<Subscriber>> &result)
+        {
+            auto multi = node.children.find(MultiLevelWildcard);
+            if (multi != node.children.end())
+            {
+                result.insert(result.end(), multi->second->subscribers.begin(), multi->second->subscribers.end());
+            }
+            if (depth == levels.size())
+            {
+                result.insert(result.end(), node.subscribers.begin(), node.subscribers.end());
+                return;
+            }
+            auto exact = node.children.find(levels[depth]);
+            if (exact != node.children.end())
+            {
+                MatchTrie(*exact->second, levels, depth + 1, result);
+            }
+            auto single = node.children.find(SingleLevelWildcard);
+            if (single != node.children.end())
+            {
+                MatchTrie(*single->second, levels, depth + 1, result);
+            }
+        }
+
+        template<typename U, typename ...SlotArgs>
+        static std::shared_ptr<HandlerInterface> MakeHandler(U &&t, void(std::decay_t<U>::*)(SlotArgs...))
+        {
+            return std::make_shared<Implementation::EventHandler<void, std::tuple<SlotArgs...>, Topic, Args...>>(std::forward<U>(t));
+        }
+
+        template<typename U, typename ...SlotArgs>
+        static std::shared_ptr<HandlerInterface> MakeHandler(U &&t, void(std::decay_t<U>::*)(SlotArgs...) const)
+        {
+            return std::make_shared<Implementation::EventHandler<void, std::tuple<SlotArgs...>, Topic, Args...>>(std::forward<U>(t));
+        }
+
+        std::size_t AddSubscriber(const std::string &pattern, const std::shared_ptr<Subscriber> &subscriber)
+        {
+            auto levels = SplitLevels(pattern);
+            std::unique_lock<std::shared_mutex> lock(m_RouterMutex);
+            for (std::size_t i = 0; i < levels.size(); ++i)
+            {
+                if (levels[i] == "#" && i + 1 != levels.size())
+                {
+                    return 0;
+                }
+                subscriber->pattern.push_back(InternLevel(levels[i]));
+            }
+
+            TrieNode *node = &m_Root;
+            for (auto level: subscriber->pattern)
+            {
+                auto &child = node->children[level];
+                if (!child)
+                {
+                    child = std::make_unique<TrieNode>();
+                }
+                node = child.get();
+            }
+            subscriber->id = m_SubscriberIdAutoIncrease++;
+            node->subscribers.push_back(subscriber);
+            m_Subscribers.insert(std::make_pair(subscriber->id, subscriber));
+
+            for (auto &entry: m_TopicEntries)
+            {
+                if (MatchPattern(subscriber->pattern, entry.levels))
+                {
+                    entry.subscribers.push_back(subscriber);
+                }
+            }
+            return subscriber->id;
+        }
+
+        static ClassFunctionPointer SubscriptionKey(std::size_t id) noexcept
+        {
+            ClassFunctionPointer key;
+            key.address = reinterpret_cast<void *>(id);
+            return key;
+        }
+
+    public:
+        Topic Intern(const std::string &name)
+        {
+            {
+                std::shared_lock<std::shared_mutex> lock(m_RouterMutex);
+                auto iter = m_Topics.find(name);
+                if (iter != m_Topics.end())
+                {
+                    return iter->second;
+                }
+            }
+
+            auto levels = SplitLevels(name);
+            std::unique_lock<std::shared_mutex> lock(m_RouterMutex);
+            auto iter = m_Topics.find(name);
+            if (iter != m_Topics.end())
+            {
+                return iter->second;
+            }
+
+            TopicEntry entry;
+            entry.name = name;
+            for (auto &level: levels)
+            {
+                auto id = InternLevel(level);
+                if (id == SingleLevelWildcard || id == MultiLevelWildcard)
+                {
+                    return Topic{};
+                }
+                entry.levels.push_back(id);
+            }
+            MatchTrie(m_Root, entry.levels, 0, entry.subscribers);
+            m_TopicEntries.push_back(std::move(entry));
+
+            Topic topic{ static_cast<uint32_t>(m_TopicEntries.size()) };
+            m_Topics.insert(std::make_pair(name, topic));
+            return topic;
+        }
+
+        std::string TopicName(Topic topic) const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_RouterMutex);
+            if (!topic.IsValid() || topic.id > m_TopicEntries.size())
+            {
+                return std::string();
+            }
+            return m_TopicEntries[topic.id - 1].name;
+        }
+
+        void Publish(Topic topic, const Args &... args)
+        {
+            std::shared_lock<std::shared_mutex> lock(m_RouterMutex);
+            if (!topic.IsValid() || topic.id > m_TopicEntries.size())
+            {
+                return;
+            }
+            for (auto &&subscriber: m_TopicEntries[topic.id - 1].subscribers)
+            {
+                Implementation::DispatchEvent(subscriber->threadId, subscriber->type, subscriber->handler, Implementation::KeyedPoster{ subscriber->receiver }, topic, args...);
+            }
+        }
+
+        void Publish(const std::string &name, const Args &... args)
+        {
+            Publish(Intern(name), args...);
+        }
+
+        template<typename Receiver, typename Lambda>
+        std::size_t Subscribe(const std::string &pattern, Receiver *receiver, Lambda &&lambda, ConnectionType type = ConnectionType::AutoConnection)
+        {
+            static_assert(Implementation::is_object<Receiver, std::thread::id>::value, "Receiver must be Object");
+            auto subscriber = std::make_shared<Subscriber>();
+            subscriber->threadId = receiver->ThreadId();
+            subscriber->handler = MakeHandler(std::forward<Lambda>(lambda), &std::decay_t<Lambda>::operator());
+            subscriber->type = type;
+            subscriber->receiver = receiver;
+
+            auto id = AddSubscriber(pattern, subscriber);
+            if (id == 0)
+            {
+                return 0;
+            }
+
+            Address routerAddress(this, SubscriptionKey(id));
+            Address receiverAddress(receiver, SubscriptionKey(id));
+            auto receiverWeakFlag = receiver->GetWeakFlag();
+            auto routerWeakFlag = GetWeakFlag();
+            Implementation::AddReceiver(*this, receiverAddress, [=]()
+            {
+                if (!receiverWeakFlag.expired())
+                {
+                    Implementation::RemoveSender(*receiver, routerAddress, routerAddress.function);
+                }
+            });
+            Implementation::AddSender(*receiver, routerAddress, routerAddress.function, [=]()
+            {
+                if (!routerWeakFlag.expired())
+                {
+                    Unsubscribe(id);
+                }
+            });
+            return id;
+        }
+
+        template<typename Lambda>
+        std::size_t Subscribe(const std::string &pattern, Lambda &&lambda)
+        {
+            auto subscriber = std::make_shared<Subscriber>();
+            subscriber->threadId = std::this_thread::get_id();
+            subscriber->handler = MakeHandler(std::forward<Lambda>(lambda), &std::decay_t<Lambda>::operator());
+            subscriber->type = ConnectionType::DirectConnection;
+            return AddSubscriber(pattern, subscriber);
+        }
+
+        void Unsubscribe(std::size_t id)
+        {
+            std::shared_ptr<Subscriber> subscriber;
+            {
+                std::unique_lock<std::shared_mutex> lock(m_RouterMutex);
+                auto iter = m_Subscribers.find(id);
+                if (iter == m_Subscribers.end())
+                {
+                    return;
+                }
+                subscriber = iter->second;
+                m_Subscribers.erase(iter);
+
+                auto erase = [&](std::vector<std::shared_ptr<Subscriber>> &list)
+                {
+                    list.erase(std::remove(list.begin(), list.end(), subscriber), list.end());
+                };
+                TrieNode *node = &m_Root;
+                for (auto level: subscriber->pattern)
+                {
+                    node = node->children.at(level).get();
+                }
+                erase(node->subscribers);
+                for (auto &entry: m_TopicEntries)
+                {
+                    erase(entry.subscribers);
+                }
+            }
+
+            if (subscriber->receiver != nullptr)
+            {
+                Address routerAddress(this, SubscriptionKey(id));
+                Address receiverAddress(subscriber->receiver, SubscriptionKey(id));
+                Implementation::RemoveReceiver(*this, receiverAddress);
+                if (Implementation::ContainSender(*subscriber->receiver, routerAddress))
+                {
+                    Implementation::RemoveSender(*subscriber->receiver, routerAddress, routerAddress.function);
+                }
+            }
+        }
+    };
+
+
+    namespace Implementation
+    {
+        class ComputedNode;
+
+        inline void NotifyInputChanged(ComputedNode *node);
+
+        class PropertyHooks
+        {
+        private:
+            std::mutex m_Mutex;
+            std::vector<ComputedNode *> m_Dependents;
+            std::atomic<std::size_t> m_Count = 0;
+            std::atomic<uint64_t> m_Epoch = 0;
+
+        public:
+            uint64_t Epoch() const noexcept
+            {
+                return m_Epoch.load(std::memory_order_acquire);
+            }
+
+            void Add(ComputedNode *node)
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Dependents.push_back(node);
+                m_Count.store(m_Dependents.size(), std::memory_order_release);
+            }
+
+            void Remove(ComputedNode *node)
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Dependents.erase(std::remove(m_Dependents.begin(), m_Dependents.end(), node), m_Dependents.end());
+                m_Count.store(m_Dependents.size(), std::memory_order_release);
+            }
+
+            void Notify()
+            {
+                if (m_Count.load(std::memory_order_acquire) == 0)
+                {
+                    return;
+                }
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                for (auto node: m_Dependents)
+                {
+                    NotifyInputChanged(node);
+                }
+                m_Epoch.fetch_add(1, std::memory_order_release);
+            }
+        };
+
+        template<typename T, bool = std::is_trivially_copyable_v<T>>
+        class PropertyStorage
+        {
+        private:
+            T m_Value;
+            mutable std::shared_mutex m_Mutex;
+        public:
+            explicit PropertyStorage(const T &value) : m_Value(value)
+            {
+            }
+
+            T Load() const
+            {
+                std::shared_lock<std::shared_mutex> lock(m_Mutex);
+                return m_Value;
+            }
+
+            bool Store(const T &value)
+            {
+                std::unique_lock<std::shared_mutex> lock(m_Mutex);
+                if (m_Value == value)
+                {
+                    return false;
+                }
+                m_Value = value;
+                return true;
+            }
+        };
+
+        template<typename T>
+        class PropertyStorage<T, true>
+        {
+        private:
+            std::atomic<T> m_Value;
+        public:
+            explicit PropertyStorage(const T &value) : m_Value(value)
+            {
+            }
+
+            T Load() const noexcept
+            {
+                return m_Value.load(std::memory_order_acquire);
+            }
+
+            bool Store(const T &value) noexcept
+            {
+                return !(m_Value.exchange(value, std::memory_order_acq_rel) == value);
+            }
+        };
+    }
+
+    /**
+     * @brief value member that emits changed only when the stored value really changes
+     * - writes from any thread are coalesced into one notification on the owner's event loop
+     * - without an owner loop the writer notifies directly, concurrent writers are serialized so the last emitted value is the stored one
+     * - Get() is lock-free for trivially copyable T
+     */
+    template<typename T>
+    class Property
+    {
+    private:
+        Object *m_Owner = nullptr;
+        std::thread::id m_Id = std::this_thread::get_id();
+        Implementation::PropertyStorage<T> m_Value;
+        std::mutex m_NotifyMutex;
+        T m_NotifiedValue;
+        bool m_Notifying = false;
+        std::atomic<bool> m_NotifyPending = false;
+        std::shared_ptr<WeakFlag> m_WeakFlag = std::make_shared<WeakFlag>();
+        std::shared_ptr<Implementation::PropertyHooks> m_Hooks = std::make_shared<Implementation::PropertyHooks>();
+
+    private:
+        void Notify()
+        {
+            m_NotifyPending.store(false, std::memory_order_release);
+            std::unique_lock<std::mutex> lock(m_NotifyMutex);
+            if (m_Notifying)
+            {
+                return;
+            }
+            m_Notifying = true;
+            for (;;)
+            {
+                T value = m_Value.Load();
+                if (value == m_NotifiedValue)
+                {
+                    break;
+                }
+                m_NotifiedValue = value;
+                lock.unlock();
+                changed.Emit(value);
+                lock.lock();
+            }
+            m_Notifying = false;
+        }
+
+    public:
+        Property(const Property &) = delete;
+        Property &operator=(const Property &) = delete;
+
+        explicit Property(Object *owner = nullptr, const T &value = T()) : m_Owner(owner), m_Value(value), m_NotifiedValue(value)
+        {
+        }
+
+        T Get() const
+        {
+            return m_Value.Load();
+        }
+
+        operator T() const
+        {
+            return Get();
+        }
+
+        bool Set(const T &value)
+        {
+            if (!m_Value.Store(value))
+            {
+                return false;
+            }
+            m_Hooks->Notify();
+            if (m_NotifyPending.exchange(true, std::memory_order_acq_rel))
+            {
+                return true;
+            }
+
+            EventLoop *loop = m_Owner ? m_Owner->GetEventLoop() : winSignal::GetEventLoop(m_Id);
+            if (loop == nullptr)
+            {
+                Notify();
+                return true;
+            }
+            std::weak_ptr<WeakFlag> weakFlag = m_WeakFlag;
+            loop->PostEvent([=]()
+            {
+                if (!weakFlag.expired())
+                {
+                    Notify();
+                }
+            });
+            return true;
+        }
+
+        Property &operator=(const T &value)
+        {
+            Set(value);
+            return *this;
+        }
+
+    public:
+        winSignal::Signal<T> changed;
+
+        template<typename U>
+        friend class Computed;
+    };
+
+
+    namespace Implementation
+    {
+        class ComputedNode
+        {
+        public:
+            std::vector<ComputedNode *> dependencies;
+            std::vector<uint64_t> seenVersions;
+            std::vector<ComputedNode *> dependents;
+            std::vector<std::shared_ptr<PropertyHooks>> sources;
+            int level = 0;
+            uint64_t version = 0;
+            uint64_t checkedEpoch = 0;
+            bool dirty = true;
+            bool scheduled = false;
+            std::atomic<bool> inputChanged = false;
+
+        public:
+            ComputedNode() = default;
+            ComputedNode(const ComputedNode &) = delete;
+            ComputedNode &operator=(const ComputedNode &) = delete;
+            virtual ~ComputedNode();
+
+            virtual void Update() = 0;
+            virtual void Publish() = 0;
+            virtual void InputChanged() = 0;
+
+            void AddDependency(ComputedNode *node)
+            {
+                dependencies.push_back(node);
+                seenVersions.push_back(node->version);
+                node->dependents.push_back(this);
+                level = (std::max)(level, node->level + 1);
+                for (auto &hooks: node->sources)
+                {
+                    AddSource(hooks);
+                }
+            }
+
+            void AddSource(const std::shared_ptr<PropertyHooks> &hooks)
+            {
+                if (std::find(sources.begin(), sources.end(), hooks) == sources.end())
+                {
+                    sources.push_back(hooks);
+                }
+            }
+
+            /** @brief sum of the write epochs of every property upstream - changes only when one of them is written */
+            uint64_t SourceEpoch() const noexcept
+            {
+                uint64_t epoch = 0;
+                for (auto &hooks: sources)
+                {
+                    epoch += hooks->Epoch();
+                }
+                return epoch;
+            }
+
+            void MarkDirty();
+            void Invalidate();
+        };
+
+        class ComputedScheduler
+        {
+        private:
+            std::vector<ComputedNode *> m_Pending;
+            bool m_FlushPosted = false;
+            ComputedScheduler() = default;
+
+        public:
+            ComputedScheduler(const ComputedScheduler &) = delete;
+            ComputedScheduler &operator=(const ComputedScheduler &) = delete;
+
+            static ComputedScheduler *GetInstance() noexcept
+            {
+                thread_local ComputedScheduler instance;
+                return &instance;
+            }
+
+            void Schedule(ComputedNode *node)
+            {
+                m_Pending.push_back(node);
+            }
+
+            void Unschedule(ComputedNode *node)
+            {
+                m_Pending.erase(std::remove(m_Pending.begin(), m_Pending.end(), node), m_Pending.end());
+            }
+
+            void RequestFlush()
+            {
+                if (m_FlushPosted || m_Pending.empty())
+                {
+                    return;
+                }
+                EventLoop *loop = EventLoopManager::GetInstance()->GetEventLoop(std::this_thread::get_id());
+                if (loop == nullptr)
+                {
+                    Flush();
+                    return;
+                }
+                m_FlushPosted = true;
+                loop->PostEvent([this]()
+                {
+                    Flush();
+                });
+            }
+
+            void Flush()
+            {
+                m_FlushPosted = false;
+                std::vector<ComputedNode *> pending;
+                pending.swap(m_Pending);
+                std::stable_sort(pending.begin(), pending.end(), [](const ComputedNode *lhs, const ComputedNode *rhs)
+                {
+                    return lhs->level < rhs->level;
+                });
+                for (auto node: pending)
+                {
+                    node->scheduled = false;
+                }
+                for (auto node: pending)
+                {
+                    node->Publish();
+                }
+            }
+        };
+
+        inline ComputedNode::~ComputedNode()
+        {
+            for (auto node: dependencies)
+            {
+                node->dependents.erase(std::remove(node->dependents.begin(), node->dependents.end(), this), node->dependents.end());
+            }
+            for (auto node: dependents)
+            {
+                auto iter = std::find(node->dependencies.begin(), node->dependencies.end(), this);
+                if (iter != node->dependencies.end())
+                {
+                    node->seenVersions.erase(node->seenVersions.begin() + (iter - node->dependencies.begin()));
+                    node->dependencies.erase(iter);
+                }
+            }
+            if (scheduled)
+            {
+                ComputedScheduler::GetInstance()->Unschedule(this);
+            }
+        }
+
+        inline void ComputedNode::MarkDirty()
+        {
+            dirty = true;
+            if (scheduled)
+            {
+                return;
+            }
+            scheduled = true;
+            ComputedScheduler::GetInstance()->Schedule(this);
+            for (auto node: dependents)
+            {
+                node->MarkDirty();
+            }
+        }
+
+        inline void ComputedNode::Invalidate()
+        {
+            MarkDirty();
+            ComputedScheduler::GetInstance()->RequestFlush();
+        }
+
+        inline void NotifyInputChanged(ComputedNode *node)
+        {
+            node->InputChanged();
+        }
+    }
+
+    /**
+     * @brief derived value recomputed from properties, other computed values or signals
+     * - input changes only mark the node and its dependents dirty, property writes are seen by the next Get()
+     *   right away while changed still follows the property's coalesced notification
+     * - the value is recomputed on Get(), or once per loop iteration in dependency order when changed is connected
+     */
+    template<typename T>
+    class Computed : public Object, private Implementation::ComputedNode
+    {
+    private:
+        std::function<T()> m_Compute;
+        T m_Value{};
+        T m_NotifiedValue{};
+        bool m_HasNotifiedValue = false;
+        std::size_t m_RecomputeCount = 0;
+        bool m_HasValue = false;
+        std::vector<std::shared_ptr<Implementation::PropertyHooks>> m_PropertyHooks;
+
+    private:
+        void Update() final
+        {
+            uint64_t epoch = SourceEpoch();
+            if (!dirty && m_HasValue && checkedEpoch == epoch && !inputChanged.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            bool stale = !m_HasValue;
+            if (inputChanged.exchange(false, std::memory_order_acq_rel))
+            {
+                stale = true;
+            }
+            for (std::size_t i = 0; i < dependencies.size(); ++i)
+            {
+                dependencies[i]->Update();
+                stale = stale || dependencies[i]->version != seenVersions[i];
+            }
+            checkedEpoch = epoch;
+            if (!stale)
+            {
+                dirty = false;
+                return;
+            }
+            T value = m_Compute();
+            m_HasValue = true;
+            ++m_RecomputeCount;
+            if (!(value == m_Value))
+            {
+                m_Value = std::move(value);
+                ++version;
+            }
+            for (std::size_t i = 0; i < dependencies.size(); ++i)
+            {
+                seenVersions[i] = dependencies[i]->version;
+            }
+            dirty = false;
+        }
+
+        void InputChanged() final
+        {
+            inputChanged.store(true, std::memory_order_release);
+            if (ThreadId() == std::this_thread::get_id())
+            {
+                MarkDirty();
+            }
+        }
+
+        void Publish() final
+        {
+            if (changed.HandlerCount() == 0)
+            {
+                return;
+            }
+            Update();
+            if (m_HasNotifiedValue && m_NotifiedValue == m_Value)
+            {
+                return;
+            }
+            m_NotifiedValue = m_Value;
+            m_HasNotifiedValue = true;
+            changed.Emit(m_Value);
+        }
+
+        template<typename U>
+        void AddInput(Property<U> &property)
+        {
+            property.m_Hooks->Add(this);
+            m_PropertyHooks.push_back(property.m_Hooks);
+            AddSource(property.m_Hooks);
+            DependOn(&property, &Property<U>::changed);
+        }
+
+        template<typename U>
+        void AddInput(Computed<U> &computed)
+        {
+            Implementation::ComputedNode::AddDependency(&computed);
+        }
+
+    public:
+        template<typename Callable, typename ...Inputs>
+        explicit Computed(Callable &&compute, Inputs &... inputs) : m_Compute(std::forward<Callable>(compute))
+        {
+            (AddInput(inputs), ...);
+        }
+
+        ~Computed()
+        {
+            for (auto &hooks: m_PropertyHooks)
+            {
+                hooks->Remove(this);
+            }
+        }
+
+        template<typename Sender, typename U, typename ...SignalArgs>
+        void DependOn(Sender *sender, Signal<SignalArgs...> U::* event)
+        {
+            winSignal::Connect(sender, event, this, [this]()
+            {
+                inputChanged.store(true, std::memory_order_release);
+                Invalidate();
+            });
+        }
+
+        T Get()
+        {
+            Update();
+            return m_Value;
+        }
+
+        bool IsDirty() const noexcept
+        {
+            return dirty || inputChanged.load(std::memory_order_acquire);
+        }
+
+        std::size_t RecomputeCount() const noexcept
+        {
+            return m_RecomputeCount;
+        }
+
+    public:
+        winSignal::Signal<T> changed;
+
+        template<typename U>
+        friend class Computed;
+    };
+
+
+    template<typename State, typename Event>
+    struct Transition
+    {
+        State from;
+        Event event;
+        State to;
+    };
+
+    /**
+     * @brief dense state x event lookup table built at compile time
+     * - State and Event are enums numbered from 0, their Count enumerator gives the table size by default
+     */
+    template<typename State, typename Event, std::size_t StateCount = static_cast<std::size_t>(State::Count), std::size_t EventCount = static_cast<std::size_t>(Event::Count)>
+    class TransitionTable
+    {
+    public:
+        constexpr static std::size_t States = StateCount;
+        constexpr static std::size_t Events = EventCount;
+        constexpr static std::size_t NoTransition = StateCount;
+
+    private:
+        std::array<std::size_t, StateCount * EventCount> m_Next{};
+
+    public:
+        template<std::size_t N>
+        constexpr explicit TransitionTable(const Transition<State, Event> (&transitions)[N]) noexcept
+        {
+            for (std::size_t i = 0; i < m_Next.size(); ++i)
+            {
+                m_Next[i] = NoTransition;
+            }
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                m_Next[Index(transitions[i].from, transitions[i].event)] = static_cast<std::size_t>(transitions[i].to);
+            }
+        }
+
+        constexpr static std::size_t Index(State state, Event event) noexcept
+        {
+            return static_cast<std::size_t>(state) * EventCount + static_cast<std::size_t>(event);
+        }
+
+        constexpr std::size_t Next(State state, Event event) const noexcept
+        {
+            return m_Next[Index(state, event)];
+        }
+
+        constexpr bool Contains(State state, Event event) const noexcept
+        {
+            return Next(state, event) != NoTransition;
+        }
+    };
+
+    /**
+     * @brief state machine driven by a TransitionTable
+     * - signals are bound to events once, transitions never connect or disconnect
+     * - events, entry and exit actions always run on the owner's thread, events raised by actions are queued until the current transition completes
+     */
+    template<typename State, typename Event, std::size_t StateCount = static_cast<std::size_t>(State::Count), std::size_t EventCount = static_cast<std::size_t>(Event::Count)>
+    class StateMachine : public Object
+    {
+    public:
+        using Table = TransitionTable<State, Event, StateCount, EventCount>;
+
+    private:
+        Table m_Table;
+        std::atomic<State> m_State;
+        std::array<std::function<void()>, StateCount> m_EntryActions;
+        std::array<std::function<void()>, StateCount> m_ExitActions;
+        std::deque<Event> m_PendingEvents;
+        bool m_Processing = false;
+
+    private:
+        void Process(Event event)
+        {
+            m_PendingEvents.push_back(event);
+            if (m_Processing)
+            {
+                return;
+            }
+            m_Processing = true;
+            // an action that throws must not leave the machine marked busy with a stale queue behind
+            struct ProcessingGuard
+            {
+                StateMachine *machine;
+
+                ~ProcessingGuard()
+                {
+                    machine->m_Processing = false;
+                    machine->m_PendingEvents.clear();
+                }
+            } guard{ this };
+            while (!m_PendingEvents.empty())
+            {
+                Event current = m_PendingEvents.front();
+                m_PendingEvents.pop_front();
+
+                State from = m_State.load(std::memory_order_relaxed);
+                std::size_t next = m_Table.Next(from, current);
+                if (next == Table::NoTransition)
+                {
+                    unhandled.Emit(from, current);
+                    continue;
+                }
+                State to = static_cast<State>(next);
+                if (auto &exit = m_ExitActions[static_cast<std::size_t>(from)])
+                {
+                    exit();
+                }
+                m_State.store(to, std::memory_order_release);
+                if (auto &entry = m_EntryActions[static_cast<std::size_t>(to)])
+                {
+                    entry();
+                }
+                stateChanged.Emit(from, to);
+            }
+        }
+
+    public:
+        StateMachine(const Table &table, State initial, Object *owner = nullptr) : m_Table(table), m_State(initial)
+        {
+            if (owner != nullptr)
+            {
+                MoveToThread(owner->ThreadId());
+            }
+        }
+
+        State CurrentState() const noexcept
+        {
+            return m_State.load(std::memory_order_acquire);
+        }
+
+        template<typename Callable>
+        void OnEntry(State state, Callable &&func)
+        {
+            m_EntryActions[static_cast<std::size_t>(state)] = std::forward<Callable>(func);
+        }
+
+        template<typename Callable>
+        void OnExit(State state, Callable &&func)
+        {
+            m_ExitActions[static_cast<std::size_t>(state)] = std::forward<Callable>(func);
+        }
+
+        template<typename Sender, typename T, typename ...SignalArgs>
+        void Bind(Sender *sender, Signal<SignalArgs...> T::* signal, Event event)
+        {
+            winSignal::Connect(sender, signal, this, [this, event]()
+            {
+                Fire(event);
+            });
+        }
+
+        void Fire(Event event)
+        {
+            if (ThreadId() == std::this_thread::get_id())
+            {
+                Process(event);
+            }
+            else if (EventLoop *loop = GetEventLoop())
+            {
+                auto weakFlag = GetWeakFlag();
+                loop->PostEvent([=]()
+                {
+                    if (!weakFlag.expired())
+                    {
+                        Process(event);
+                    }
+                });
+            }
+        }
+
+    public:
+        winSignal::Signal<State, State> stateChanged;
+        winSignal::Signal<State, Event> unhandled;
+    };
+
+
+    namespace Implementation
+    {
+        template<typename T>
+        class StreamNode
+        {
+        private:
+            std::vector<std::function<void(const T &)>> m_Sinks;
+            mutable std::shared_mutex m_Mutex;
+        public:
+            template<typename Callable>
+            void AddSink(Callable &&func)
+            {
+                std::unique_lock<std::shared_mutex> lock(m_Mutex);
+                m_Sinks.emplace_back(std::forward<Callable>(func));
+            }
+
+            void Push(const T &value) const
+            {
+                std::shared_lock<std::shared_mutex> lock(m_Mutex);
+                for (auto &&sink: m_Sinks)
+                {
+                    sink(value);
+                }
+            }
+        };
+
+        template<typename ...Args>
+        struct StreamValue
+        {
+            using type = std::tuple<Args...>;
+        };
+
+        template<typename T>
+        struct StreamValue<T>
+        {
+            using type = T;
+        };
+
+        template<typename ...Args>
+        class StreamSourceHandler final : public EventHandlerInterface<Args...>
+        {
+        private:
+            std::shared_ptr<StreamNode<typename StreamValue<Args...>::type>> m_Node;
+        public:
+            explicit StreamSourceHandler(std::shared_ptr<StreamNode<typename StreamValue<Args...>::type>> node) noexcept : m_Node(std::move(node))
+            {
+            }
+
+            void operator()(const Args &... args) final
+            {
+                if constexpr (sizeof...(Args) == 1)
+                {
+                    m_Node->Push(args...);
+                }
+                else
+                {
+                    m_Node->Push(std::make_tuple(args...));
+                }
+            }
+        };
+
+        /** @brief removes a FromSignal source handler once the last Stream built on it is dropped */
+        class StreamConnection
+        {
+        private:
+            std::function<void()> m_Detach;
+        public:
+            StreamConnection(const StreamConnection &) = delete;
+            StreamConnection &operator=(const StreamConnection &) = delete;
+
+            explicit StreamConnection(std::function<void()> detach) : m_Detach(std::move(detach))
+            {
+            }
+
+            ~StreamConnection()
+            {
+                m_Detach();
+            }
+        };
+
+        /** @brief repeat timer on the creating thread's event loop - never fires when that thread has no loop */
+        class StreamTimer
+        {
+        private:
+            std::thread::id m_ThreadId;
+            UINT_PTR m_TimerId = 0;
+        public:
+            StreamTimer(const StreamTimer &) = delete;
+            StreamTimer &operator=(const StreamTimer &) = delete;
+
+            template<typename Callable>
+            StreamTimer(std::chrono::milliseconds interval, Callable &&func) : m_ThreadId(std::this_thread::get_id())
+            {
+                if (EventLoop *loop = EventLoopManager::GetInstance()->GetEventLoop(m_ThreadId))
+                {
+                    m_TimerId = loop->SetRepeatTimer(static_cast<int>(interval.count()), std::forward<Callable>(func));
+                }
+            }
+
+            ~StreamTimer()
+            {
+                if (m_TimerId == 0)
+                {
+                    return;
+                }
+                if (EventLoop *loop = EventLoopManager::GetInstance()->GetEventLoop(m_ThreadId))
+                {
+                    loop->KillTimer(m_TimerId);
+                }
+            }
+        };
+    }
+
+    /**
+     * @brief composable operator chain over signal emissions
+     * - operators run inline on the emitting thread, a chain costs plain function calls
+     * - Subscribe() with a receiver on another thread batches values into a single queued hop per drain,
+     *   values always reach the receiver in push order and are dropped while it has no event loop
+     * - time based operators tick on the event loop of the thread that created them, created on a thread without a loop they never fire
+     * - the source signal stays connected while any Stream derived from FromSignal() is alive, dropping the last one detaches it
+     */
+    template<typename T>
+    class Stream
+    {
+    private:
+        using Node = Implementation::StreamNode<T>;
+        using Connections = std::vector<std::shared_ptr<Implementation::StreamConnection>>;
+        std::shared_ptr<Node> m_Node;
+        Connections m_Connections;
+
+        template<typename U>
+        friend class Stream;
+
+        template<typename U>
+        Stream<U> Derive(std::shared_ptr<Implementation::StreamNode<U>> next) const
+        {
+            return Stream<U>(std::move(next), m_Connections);
+        }
+
+    public:
+        explicit Stream(std::shared_ptr<Node> node, Connections connections = Connections()) noexcept : m_Node(std::move(node)), m_Connections(std::move(connections))
+        {
+        }
+
+        template<typename Callable>
+        auto Map(Callable &&func) const
+        {
+            using U = std::decay_t<std::invoke_result_t<Callable &, const T &>>;
+            auto next = std::make_shared<Implementation::StreamNode<U>>();
+            m_Node->AddSink([next, func = std::forward<Callable>(func)](const T &value) mutable
+            {
+                next->Push(func(value));
+            });
+            return Derive(next);
+        }
+
+        template<typename Predicate>
+        Stream<T> Filter(Predicate &&predicate) const
+        {
+            auto next = std::make_shared<Node>();
+            m_Node->AddSink([next, predicate = std::forward<Predicate>(predicate)](const T &value) mutable
+            {
+                if (predicate(value))
+                {
+                    next->Push(value);
+                }
+            });
+            return Derive(next);
+        }
+
+        Stream<T> Merge(const Stream<T> &other) const
+        {
+            auto next = std::make_shared<Node>();
+            auto forward = [next](const T &value)
+            {
+                next->Push(value);
+            };
+            m_Node->AddSink(forward);
+            other.m_Node->AddSink(forward);
+            Stream<T> merged = Derive(next);
+            merged.m_Connections.insert(merged.m_Connections.end(), other.m_Connections.begin(), other.m_Connections.end());
+            return merged;
+        }
+
+        template<typename U>
+        Stream<std::pair<T, U>> ZipLatest(const Stream<U> &other) const
+        {
+            struct State
+            {
+                std::mutex mutex;
+                std::optional<T> first;
+                std::optional<U> second;
+            };
+            auto state = std::make_shared<State>();
+            auto next = std::make_shared<Implementation::StreamNode<std::pair<T, U>>>();
+            m_Node->AddSink([state, next](const T &value)
+            {
+                std::optional<std::pair<T, U>> pair;
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->first = value;
+                    if (state->second)
+                    {
+                        pair.emplace(*state->first, *state->second);
+                    }
+                }
+                if (pair)
+                {
+                    next->Push(*pair);
+                }
+            });
+            other.m_Node->AddSink([state, next](const U &value)
+            {
+                std::optional<std::pair<T, U>> pair;
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->second = value;
+                    if (state->first)
+                    {
+                        pair.emplace(*state->first, *state->second);
+                    }
+                }
+                if (pair)
+                {
+                    next->Push(*pair);
+                }
+            });
+            Stream<std::pair<T, U>> zipped = Derive(next);
+            zipped.m_Connections.insert(zipped.m_Connections.end(), other.m_Connections.begin(), other.m_Connections.end());
+            return zipped;
+        }
+
+        Stream<std::vector<T>> Buffer(std::size_t count) const
+        {
+            struct State
+            {
+                std::mutex mutex;
+                std::vector<T> values;
+            };
+            auto state = std::make_shared<State>();
+            auto next = std::make_shared<Implementation::StreamNode<std::vector<T>>>();
+            m_Node->AddSink([state, next, count](const T &value)
+            {
+                std::vector<T> values;
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->values.push_back(value);
+                    if (state->values.size() < count)
+                    {
+                        return;
+                    }
+                    values.swap(state->values);
+                }
+                next->Push(values);
+            });
+            return Derive(next);
+        }
+
+        Stream<std::vector<T>> Buffer(std::chrono::milliseconds period) const
+        {
+            struct State
+            {
+                std::mutex mutex;
+                std::vector<T> values;
+                std::unique_ptr<Implementation::StreamTimer> timer;
+            };
+            auto state = std::make_shared<State>();
+            auto next = std::make_shared<Implementation::StreamNode<std::vector<T>>>();
+            std::weak_ptr<State> weakState = state;
+            std::weak_ptr<Implementation::StreamNode<std::vector<T>>> weakNext = next;
+            state->timer = std::make_unique<Implementation::StreamTimer>(period, [weakState, weakNext]()
+            {
+                auto state = weakState.lock();
+                auto next = weakNext.lock();
+                if (!state || !next)
+                {
+                    return;
+                }
+                std::vector<T> values;
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    values.swap(state->values);
+                }
+                if (!values.empty())
+                {
+                    next->Push(values);
+                }
+            });
+            m_Node->AddSink([state, next](const T &value)
+            {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->values.push_back(value);
+            });
+            return Derive(next);
+        }
+
+        template<typename Aggregate>
+        auto Window(std::size_t count, Aggregate &&aggregate) const
+        {
+            using U = std::decay_t<std::invoke_result_t<Aggregate &, const std::deque<T> &>>;
+            struct State
+            {
+                std::mutex mutex;
+                std::deque<T> values;
+            };
+            auto state = std::make_shared<State>();
+            auto next = std::make_shared<Implementation::StreamNode<U>>();
+            m_Node->AddSink([state, next, count, aggregate = std::forward<Aggregate>(aggregate)](const T &value) mutable
+            {
+                std::optional<U> result;
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->values.push_back(value);
+                    if (state->values.size() > count)
+                    {
+                        state->values.pop_front();
+                    }
+                    result.emplace(aggregate(state->values));
+                }
+                next->Push(*result);
+            });
+            return Derive(next);
+        }
+
+        Stream<T> Sample(std::chrono::milliseconds period) const
+        {
+            struct State
+            {
+                std::mutex mutex;
+                std::optional<T> latest;
+                std::unique_ptr<Implementation::StreamTimer> timer;
+            };
+            auto state = std::make_shared<State>();
+            auto next = std::make_shared<Node>();
+            std::weak_ptr<State> weakState = state;
+            std::weak_ptr<Node> weakNext = next;
+            state->timer = std::make_unique<Implementation::StreamTimer>(period, [weakState, weakNext]()
+            {
+                auto state = weakState.lock();
+                auto next = weakNext.lock();
+                if (!state || !next)
+                {
+                    return;
+                }
+                std::optional<T> latest;
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    latest.swap(state->latest);
+                }
+                if (latest)
+                {
+                    next->Push(*latest);
+                }
+            });
+            m_Node->AddSink([state, next](const T &value)
+            {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->latest = value;
+            });
+            return Derive(next);
+        }
+
+        template<typename Callable>
+        void Subscribe(Callable &&func) const
+        {
+            m_Node->AddSink(std::forward<Callable>(func));
+        }
+
+        template<typename Receiver, typename Callable>
+        void Subscribe(Receiver *receiver, Callable &&func) const
+        {
+            static_assert(Implementation::is_object<Receiver, std::thread::id>::value, "Receiver must be Object");
+            struct Batch
+            {
+                std::mutex mutex;
+                std::vector<T> values;
+                bool posted = false;
+            };
+            // one swap per posted drain, values that arrive meanwhile are handed to the next post so the loop is never held
+            struct Drain
+            {
+                std::shared_ptr<Batch> batch;
+                std::weak_ptr<WeakFlag> weakFlag;
+                std::shared_ptr<std::function<void(const T &)>> handler;
+                Receiver *receiver;
+
+                void operator()() const
+                {
+                    std::vector<T> values;
+                    {
+                        std::unique_lock<std::mutex> lock(batch->mutex);
+                        values.swap(batch->values);
+                    }
+                    for (auto &&value: values)
+                    {
+                        if (weakFlag.expired())
+                        {
+                            return;
+                        }
+                        (*handler)(value);
+                    }
+                    {
+                        std::unique_lock<std::mutex> lock(batch->mutex);
+                        if (batch->values.empty() || weakFlag.expired())
+                        {
+                            batch->posted = false;
+                            return;
+                        }
+                    }
+                    if (EventLoop *loop = receiver->GetEventLoop())
+                    {
+                        loop->PostEvent(*this);
+                        return;
+                    }
+                    std::unique_lock<std::mutex> lock(batch->mutex);
+                    batch->values.clear();
+                    batch->posted = false;
+                }
+            };
+            auto batch = std::make_shared<Batch>();
+            auto weakFlag = receiver->GetWeakFlag();
+            auto handler = std::make_shared<std::function<void(const T &)>>(std::forward<Callable>(func));
+            m_Node->AddSink([=](const T &value)
+            {
+                if (weakFlag.expired())
+                {
+                    return;
+                }
+                bool direct = false;
+                {
+                    std::unique_lock<std::mutex> lock(batch->mutex);
+                    if (!batch->posted && batch->values.empty() && receiver->ThreadId() == std::this_thread::get_id())
+                    {
+                        direct = true;
+                    }
+                    else
+                    {
+                        batch->values.push_back(value);
+                        if (batch->posted)
+                        {
+                            return;
+                        }
+                        batch->posted = true;
+                    }
+                }
+                if (direct)
+                {
+                    (*handler)(value);
+                    return;
+                }
+                EventLoop *loop = receiver->GetEventLoop();
+                if (loop == nullptr)
+                {
+                    std::unique_lock<std::mutex> lock(batch->mutex);
+                    batch->values.clear();
+                    batch->posted = false;
+                    return;
+                }
+                loop->PostEvent(Drain{ batch, weakFlag, handler, receiver });
+            });
+        }
+    };
+
+    template<typename Sender, typename T, typename ...SignalArgs>
+    inline auto FromSignal(Sender *sender, Signal<SignalArgs...> T::* event)
+    {
+        using Value = typename Implementation::StreamValue<SignalArgs...>::type;
+        auto node = std::make_shared<Implementation::StreamNode<Value>>();
+        auto &signal = static_cast<T *>(sender)->*event;
+        Implementation::Address address(node.get(), Implementation::ClassFunctionPointer{});
+        Implementation::SignalAccess::AddHandler(signal, address, std::this_thread::get_id(),
+            std::make_shared<Implementation::StreamSourceHandler<SignalArgs...>>(node), ConnectionType::DirectConnection);
+        auto connection = std::make_shared<Implementation::StreamConnection>([signal = &signal, weakFlag = signal.GetWeakFlag(), address]()
+        {
+            if (!weakFlag.expired())
+            {
+                Implementation::SignalAccess::RemoveHandler(*signal, address);
+            }
+        });
+        return Stream<Value>(node, { connection });
+    }
+
+
+    template<typename T>
+    class Span
+    {
+    private:
+        T *m_Data = nullptr;
+        std::size_t m_Size = 0;
+    public:
+        constexpr Span() noexcept = default;
+
+        constexpr Span(T *data, std::size_t size) noexcept : m_Data(data), m_Size(size)
+        {
+        }
+
+        constexpr T *Data() const noexcept
+        {
+            return m_Data;
+        }
+
+        constexpr std::size_t Size() const noexcept
+        {
+            return m_Size;
+        }
+
+        constexpr bool Empty() const noexcept
+        {
+            return m_Size == 0;
+        }
+
+        constexpr T &operator[](std::size_t index) const noexcept
+        {
+            return m_Data[index];
+        }
+
+        constexpr T *begin() const noexcept
+        {
+            return m_Data;
+        }
+
+        constexpr T *end() const noexcept
+        {
+            return m_Data + m_Size;
+        }
+    };
+
+    namespace Implementation
+    {
+        /** @brief contiguous bool column - std::vector<bool> is bit packed and has no data() to hand out as a Span */
+        class BoolColumn
+        {
+        private:
+            std::unique_ptr<bool[]> m_Data;
+            std::size_t m_Size = 0;
+            std::size_t m_Capacity = 0;
+        public:
+            using value_type = bool;
+
+            void push_back(bool value)
+            {
+                if (m_Size == m_Capacity)
+                {
+                    std::size_t capacity = (std::max)(std::size_t(16), m_Capacity * 2);
+                    std::unique_ptr<bool[]> data(new bool[capacity]);
+                    std::copy(m_Data.get(), m_Data.get() + m_Size, data.get());
+                    m_Data = std::move(data);
+                    m_Capacity = capacity;
+                }
+                m_Data[m_Size++] = value;
+            }
+
+            void clear() noexcept
+            {
+                m_Size = 0;
+            }
+
+            const bool *data() const noexcept
+            {
+                return m_Data.get();
+            }
+
+            std::size_t size() const noexcept
+            {
+                return m_Size;
+            }
+        };
+
+        template<typename T>
+        struct BatchColumn
+        {
+            using type = std::vector<T>;
+        };
+
+        template<>
+        struct BatchColumn<bool>
+        {
+            using type = BoolColumn;
+        };
+
+        template<typename ...Args>
+        class BatchEventHandler final : public EventHandlerInterface<Args...>
+        {
+        private:
+            using Columns = std::tuple<typename BatchColumn<std::decay_t<Args>>::type...>;
+            std::mutex m_Mutex;
+            Columns m_Pending;
+            Columns m_Draining;
+            bool m_DrainPosted = false;
+            std::thread::id m_ThreadId;
+            std::weak_ptr<WeakFlag> m_ReceiverFlag;
+            std::function<void(Span<const std::decay_t<Args>>...)> m_Handler;
+            std::weak_ptr<BatchEventHandler> m_Self;
+
+        private:
+            void Drain()
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    std::swap(m_Pending, m_Draining);
+                    m_DrainPosted = false;
+                }
+                if (!m_ReceiverFlag.expired())
+                {
+                    std::apply([this](auto &... columns)
+                    {
+                        m_Handler(Span<const typename std::decay_t<decltype(columns)>::value_type>(columns.data(), columns.size())...);
+                    }, m_Draining);
+                }
+                std::apply([](auto &... columns)
+                {
+                    (columns.clear(), ...);
+                }, m_Draining);
+            }
+
+        public:
+            template<typename Callable>
+            BatchEventHandler(std::thread::id id, std::weak_ptr<WeakFlag> receiverFlag, Callable &&func) :
+                m_ThreadId(id), m_ReceiverFlag(std::move(receiverFlag)), m_Handler(std::forward<Callable>(func))
+            {
+            }
+
+            static std::shared_ptr<BatchEventHandler> Create(std::thread::id id, std::weak_ptr<WeakFlag> receiverFlag, std::function<void(Span<const std::decay_t<Args>>...)> func)
+            {
+                auto handler = std::make_shared<BatchEventHandler>(id, std::move(receiverFlag), std::move(func));
+                handler->m_Self = handler;
+                return handler;
+            }
+
+            void operator()(const Args &... args) final
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    std::apply([&](auto &... columns)
+                    {
+                        (columns.push_back(args), ...);
+                    }, m_Pending);
+                    if (m_DrainPosted)
+                    {
+                        return;
+                    }
+                    m_DrainPosted = true;
+                }
+                EventLoop *loop = EventLoopManager::GetInstance()->GetEventLoop(m_ThreadId);
+                if (loop == nullptr)
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    std::apply([](auto &... columns)
+                    {
+                        (columns.clear(), ...);
+                    }, m_Pending);
+                    m_DrainPosted = false;
+                    return;
+                }
+                loop->PostEvent([self = m_Self.lock()]()
+                {
+                    self->Drain();
+                });
+            }
+        };
+    }
+
+    /**
+     * @brief queued connection that hands the receiver all pending emissions at once
+     * - every signal argument is kept in its own contiguous column, the slot receives one Span per argument
+     * - emissions made while the receiver's thread has no event loop are dropped
+     */
+    template<typename Sender, typename Receiver, typename T, typename Lambda, typename ...SignalArgs>
+    inline void ConnectBatched(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, Lambda &&lambda)
+    {
+        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value && Implementation::is_object<Receiver, std::thread::id>::value;
+        static_assert(is_object_v, "Sender and Receiver must both be Object");
+        Implementation::Address SenderAddress(sender, event);
+        Implementation::Address ReceiverAddress(receiver, &std::decay_t<Lambda>::operator());
+
+        auto handler = Implementation::BatchEventHandler<SignalArgs...>::Create(receiver->ThreadId(), receiver->GetWeakFlag(), std::forward<Lambda>(lambda));
+        Implementation::SignalAccess::AddHandler(static_cast<T *>(sender)->*event, ReceiverAddress, receiver->ThreadId(), handler, ConnectionType::DirectConnection);
+
+        auto receiverWeakFlag = receiver->GetWeakFlag();
+        auto senderWeakFlag = sender->GetWeakFlag();
+        auto eventWeakFlag = (static_cast<T*>(sender)->*event).GetWeakFlag();
+        Implementation::AddReceiver(*sender, ReceiverAddress, [=]()
+        {
+            if (!receiverWeakFlag.expired())
+            {
+                Implementation::RemoveSender(*receiver, SenderAddress, ReceiverAddress.function);
+            }
+        });
+        Implementation::AddSender(*receiver, SenderAddress, ReceiverAddress.function, [=]()
+        {
+            if (!eventWeakFlag.expired())
+            {
+                Implementation::SignalAccess::RemoveHandler(static_cast<T*>(sender)->*event, ReceiverAddress);
+            }
+            if (!senderWeakFlag.expired())
+            {
+                Implementation::RemoveReceiver(*sender, ReceiverAddress);
+            }
+        });
+    }
+
+
+    /**
+     * @brief single producer / single consumer ring between two threads
+     * - the producer writes with TryWrite() and makes a batch visible with Publish()
+     * - the consumer loop is woken with one posted event per batch, not per value
+     */
+    template<typename T>
+    class Channel
+    {
+    private:
+        constexpr static std::size_t CacheLineSize = 64;
+
+        struct alignas(CacheLineSize) ProducerState
+        {
+            std::atomic<std::size_t> tail = 0;
+            std::size_t cachedHead = 0;
+            std::size_t pendingTail = 0;
+        };
+
+        struct alignas(CacheLineSize) ConsumerState
+        {
+            std::atomic<std::size_t> head = 0;
+            std::size_t cachedTail = 0;
+        };
+
+    private:
+        ProducerState m_Producer;
+        ConsumerState m_Consumer;
+        alignas(CacheLineSize) std::atomic<bool> m_DrainPosted = false;
+        std::vector<T> m_Buffer;
+        std::size_t m_Mask = 0;
+        EventLoop *m_ConsumerLoop = nullptr;
+        std::function<void(T &)> m_Handler;
+        std::shared_ptr<WeakFlag> m_weakFlag;
+
+    private:
+        static std::size_t RoundUpPowerOfTwo(std::size_t value) noexcept
+        {
+            std::size_t result = 2;
+            while (result < value)
+            {
+                result <<= 1;
+            }
+            return result;
+        }
+
+    public:
+        Channel(const Channel &) = delete;
+        Channel &operator=(const Channel &) = delete;
+
+        explicit Channel(EventLoop *consumer, std::size_t capacity = 1024) : m_ConsumerLoop(consumer)
+        {
+            m_Buffer.resize(RoundUpPowerOfTwo(capacity));
+            m_Mask = m_Buffer.size() - 1;
+            m_weakFlag = std::make_shared<WeakFlag>();
+        }
+
+        std::size_t Capacity() const noexcept
+        {
+            return m_Buffer.size();
+        }
+
+        template<typename Callable>
+        void OnReceive(Callable &&func)
+        {
+            m_Handler = std::forward<Callable>(func);
+        }
+
+        template<typename U>
+        bool TryWrite(U &&value)
+        {
+            std::size_t tail = m_Producer.pendingTail;
+            if (tail - m_Producer.cachedHead >= m_Buffer.size())
+            {
+                m_Producer.cachedHead = m_Consumer.head.load(std::memory_order_acquire);
+                if (tail - m_Producer.cachedHead >= m_Buffer.size())
+                {
+                    return false;
+                }
+            }
+            m_Buffer[tail & m_Mask] = std::forward<U>(value);
+            m_Producer.pendingTail = tail + 1;
+            return true;
+        }
+
+        void Publish()
+        {
+            if (m_Producer.pendingTail == m_Producer.tail.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            m_Producer.tail.store(m_Producer.pendingTail, std::memory_order_seq_cst);
+            if (m_ConsumerLoop != nullptr && !m_DrainPosted.exchange(true, std::memory_order_seq_cst))
+            {
+                std::weak_ptr<WeakFlag> weakFlag = m_weakFlag;
+                m_ConsumerLoop->PostEvent([this, weakFlag]()
+                {
+                    if (!weakFlag.expired())
+                    {
+                        m_DrainPosted.store(false, std::memory_order_seq_cst);
+                        Consume();
+                    }
+                });
+            }
+        }
+
+        template<typename U>
+        bool TryPush(U &&value)
+        {
+            if (!TryWrite(std::forward<U>(value)))
+            {
+                return false;
+            }
+            Publish();
+            return true;
+        }
+
+        template<typename Iterator>
+        Iterator PushBatch(Iterator first, Iterator last)
+        {
+            for (; first != last; ++first)
+            {
+                if (!TryWrite(*first))
+                {
+                    break;
+                }
+            }
+            Publish();
+            return first;
+        }
+
+        std::size_t Consume()
+        {
+            std::size_t head = m_Consumer.head.load(std::memory_order_relaxed);
+            m_Consumer.cachedTail = m_Producer.tail.load(std::memory_order_seq_cst);
+            std::size_t count = m_Consumer.cachedTail - head;
+            for (; head != m_Consumer.cachedTail; ++head)
+            {
+                // take the value out so the ring does not keep consumed resources alive until the slot is reused
+                T &slot = m_Buffer[head & m_Mask];
+                T value = std::move(slot);
+                slot = T();
+                if (m_Handler)
+                {
+                    m_Handler(value);
+                }
+            }
+            m_Consumer.head.store(head, std::memory_order_release);
+            return count;
+        }
+    };
+
+
+    namespace Implementation
+    {
+        inline std::size_t JumpConsistentHash(uint64_t key, std::size_t buckets) noexcept
+        {
+            int64_t b = -1;
+            int64_t j = 0;
+            while (j < static_cast<int64_t>(buckets))
+            {
+                b = j;
+                key = key * 2862933555777941757ULL + 1;
+                j = static_cast<int64_t>(static_cast<double>(b + 1) * (static_cast<double>(1LL << 31) / static_cast<double>((key >> 33) + 1)));
+            }
+            return static_cast<std::size_t>(b);
+        }
+
+        template<std::size_t N>
+        struct KeyArgument
+        {
+            template<typename ...Args>
+            const auto &operator()(const Args &... args) const noexcept
+            {
+                return std::get<N>(std::forward_as_tuple(args...));
+            }
+        };
+
+        class GroupAccess;
+    }
+
+    /**
+     * @brief fixed set of event loop threads addressed by key
+     * - a key always maps to the same loop, so work posted per key keeps its FIFO order
+     * - keys are placed with jump consistent hashing, AddLoop() only moves keys onto the new loop
+     */
+    class EventLoopGroup
+    {
+    private:
+        struct Member
+        {
+            std::unique_ptr<EventLoopObject> object;
+            EventLoop *loop = nullptr;
+        };
+
+        struct Gate
+        {
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::size_t remaining = 0;
+        };
+
+        struct Connection
+        {
+            const void *signal = nullptr;
+            std::function<void()> disconnect;
+        };
+
+    private:
+        std::vector<Member> m_Members;
+        mutable std::shared_mutex m_Mutex;
+        std::unordered_map<Implementation::Address, Connection, Implementation::AddressHash> m_Connections;
+        std::mutex m_ConnectionMutex;
+
+        friend class Implementation::GroupAccess;
+
+    private:
+        static Member CreateMember()
+        {
+            Member member;
+            member.object = std::make_unique<EventLoopObject>();
+            member.loop = member.object->GetEventLoop();
+            return member;
+        }
+
+    public:
+        EventLoopGroup(const EventLoopGroup &) = delete;
+        EventLoopGroup &operator=(const EventLoopGroup &) = delete;
+
+        explicit EventLoopGroup(std::size_t count = std::thread::hardware_concurrency())
+        {
+            count = (std::max)(count, static_cast<std::size_t>(1));
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                m_Members.push_back(CreateMember());
+            }
+        }
+
+        /**
+         * @brief disconnect every ConnectByKey() routed to this group before its loops stop
+         */
+        ~EventLoopGroup()
+        {
+            std::unordered_map<Implementation::Address, Connection, Implementation::AddressHash> connections;
+            {
+                std::lock_guard<std::mutex> lock(m_ConnectionMutex);
+                connections.swap(m_Connections);
+            }
+            for (auto &connection: connections)
+            {
+                connection.second.disconnect();
+            }
+        }
+
+        std::size_t Size() const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            return m_Members.size();
+        }
+
+        EventLoop *GetEventLoop(std::size_t index) const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            return index < m_Members.size() ? m_Members[index].loop : nullptr;
+        }
+
+        std::thread::id ThreadId(std::size_t index) const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            return index < m_Members.size() ? m_Members[index].object->ThreadId() : std::thread::id();
+        }
+
+        std::size_t IndexOf(std::size_t hash) const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            return Implementation::JumpConsistentHash(hash, m_Members.size());
+        }
+
+        std::size_t CurrentIndex() const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            for (std::size_t i = 0; i < m_Members.size(); ++i)
+            {
+                if (m_Members[i].object->ThreadId() == std::this_thread::get_id())
+                {
+                    return i;
+                }
+            }
+            return m_Members.size();
+        }
+
+        template<typename Callable>
+        void PostByHash(std::size_t hash, Callable &&func)
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            m_Members[Implementation::JumpConsistentHash(hash, m_Members.size())].loop->PostEvent(std::forward<Callable>(func));
+        }
+
+        template<typename Key, typename Callable>
+        void PostByKey(const Key &key, Callable &&func)
+        {
+            PostByHash(std::hash<Key>{}(key), std::forward<Callable>(func));
+        }
+
+        template<typename Callable>
+        void PostTo(std::size_t index, Callable &&func)
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            if (index < m_Members.size())
+            {
+                m_Members[index].loop->PostEvent(std::forward<Callable>(func));
+            }
+        }
+
+        /**
+         * @brief add a loop and rebalance
+         * - the new loop holds its queue until every existing loop has drained the work posted before the switch,
+         *   so events for a key that moved can not overtake older ones
+         */
+        std::size_t AddLoop()
+        {
+            Member member = CreateMember();
+            auto gate = std::make_shared<Gate>();
+            std::unique_lock<std::shared_mutex> lock(m_Mutex);
+            // armed before the new loop can see it, otherwise the gate could open before any existing loop drained
+            gate->remaining = m_Members.size();
+            member.loop->PostEvent([gate]()
+            {
+                std::unique_lock<std::mutex> gateLock(gate->mutex);
+                gate->condition.wait(gateLock, [&]()
+                {
+                    return gate->remaining == 0;
+                });
+            });
+            for (auto &existing: m_Members)
+            {
+                existing.loop->PostEvent([gate]()
+                {
+                    std::unique_lock<std::mutex> gateLock(gate->mutex);
+                    if (--gate->remaining == 0)
+                    {
+                        gate->condition.notify_all();
+                    }
+                });
+            }
+            m_Members.push_back(std::move(member));
+            return m_Members.size() - 1;
+        }
+    };
+
+    namespace Implementation
+    {
+        class GroupAccess
+        {
+        public:
+            static void AddConnection(EventLoopGroup &group, const Address &address, const void *signal, std::function<void()> disconnect)
+            {
+                std::lock_guard<std::mutex> lock(group.m_ConnectionMutex);
+                group.m_Connections[address] = EventLoopGroup::Connection{ signal, std::move(disconnect) };
+            }
+
+            /** @brief detach every connection from signal whose slot has the given call operator */
+            static void RemoveConnections(EventLoopGroup &group, const void *signal, const ClassFunctionPointer &function)
+            {
+                std::vector<std::function<void()>> disconnects;
+                {
+                    std::lock_guard<std::mutex> lock(group.m_ConnectionMutex);
+                    for (auto iter = group.m_Connections.begin(); iter != group.m_Connections.end();)
+                    {
+                        if (iter->second.signal == signal && iter->first.function == function)
+                        {
+                            disconnects.push_back(std::move(iter->second.disconnect));
+                            iter = group.m_Connections.erase(iter);
+                        }
+                        else
+                        {
+                            ++iter;
+                        }
+                    }
+                }
+                for (auto &disconnect: disconnects)
+                {
+                    disconnect();
+                }
+            }
         };
+
+        template<typename KeyExtractor, typename Slot, typename ...Args>
+        class KeyedEventHandler final : public EventHandlerInterface<Args...>
+        {
+        private:
+            EventLoopGroup *m_Group;
+            KeyExtractor m_Key;
+            std::shared_ptr<Slot> m_Slot;
+        public:
+            KeyedEventHandler(EventLoopGroup *group, KeyExtractor key, std::shared_ptr<Slot> slot) : m_Group(group), m_Key(std::move(key)), m_Slot(std::move(slot))
+            {
+            }
+
+            void operator()(const Args &... args) final
+            {
+                using Key = std::decay_t<std::invoke_result_t<KeyExtractor &, const Args &...>>;
+                m_Group->PostByKey<Key>(m_Key(args...), [slot = m_Slot, args...]()
+                {
+                    (*slot)(args...);
+                });
+            }
+        };
+
+        template<typename ...Args, typename U, typename ...SlotArgs>
+        auto MakeSlot(U &&t, void(std::decay_t<U>::*)(SlotArgs...))
+        {
+            return std::make_shared<EventHandler<void, std::tuple<SlotArgs...>, Args...>>(std::forward<U>(t));
+        }
+
+        template<typename ...Args, typename U, typename ...SlotArgs>
+        auto MakeSlot(U &&t, void(std::decay_t<U>::*)(SlotArgs...) const)
+        {
+            return std::make_shared<EventHandler<void, std::tuple<SlotArgs...>, Args...>>(std::forward<U>(t));
+        }
+    }
+
+    /**
+     * @brief queued connection routed to a loop of a group by key
+     * - key is a callable over the signal arguments, KeyArgument<N> selects the N-th argument
+     * - every call adds its own connection, destroying the group disconnects it,
+     *   DisconnectByKey() with the same lambda type removes every such connection earlier
+     */
+    template<typename Sender, typename T, typename KeyExtractor, typename Lambda, typename ...SignalArgs>
+    inline void ConnectByKey(Sender *sender, Signal<SignalArgs...> T::* event, EventLoopGroup *group, KeyExtractor &&key, Lambda &&lambda)
+    {
+        using Function = decltype(&std::decay_t<Lambda>::operator());
+        Function function = &std::decay_t<Lambda>::operator();
+        auto slot = Implementation::MakeSlot<SignalArgs...>(std::forward<Lambda>(lambda), function);
+        using Slot = typename decltype(slot)::element_type;
+        auto handler = std::make_shared<Implementation::KeyedEventHandler<std::decay_t<KeyExtractor>, Slot, SignalArgs...>>(group, std::forward<KeyExtractor>(key), slot);
+        Signal<SignalArgs...> *signal = &(static_cast<T *>(sender)->*event);
+        Implementation::Address address(handler.get(), function);
+        auto eventWeakFlag = signal->GetWeakFlag();
+        Implementation::GroupAccess::AddConnection(*group, address, signal, [=]()
+        {
+            if (!eventWeakFlag.expired())
+            {
+                Implementation::SignalAccess::RemoveHandler(*signal, address);
+            }
+        });
+        Implementation::SignalAccess::AddHandler(*signal, address, std::this_thread::get_id(), handler, ConnectionType::DirectConnection);
+    }
+
+    template<typename Sender, typename T, typename Lambda, typename ...SignalArgs>
+    inline void DisconnectByKey(Sender *sender, Signal<SignalArgs...> T::* event, EventLoopGroup *group, const Lambda &)
+    {
+        Signal<SignalArgs...> *signal = &(static_cast<T *>(sender)->*event);
+        Implementation::GroupAccess::RemoveConnections(*group, signal, Implementation::Address(signal, &Lambda::operator()).function);
+    }
+
+    template<std::size_t N>
+    using KeyArgument = Implementation::KeyArgument<N>;
+
+
+    /**
+     * @brief one instance of T per loop of an EventLoopGroup
+     * - every instance is created, used and destroyed on its own loop thread, so T needs no locking
+     * - the shard list is fixed after construction and can be read from any thread without synchronization
+     * - the shards keep raw pointers to the group's loops: the group must outlive the Sharded, and loops added
+     *   with AddLoop() afterwards get no shard, so keys routed by the group and by ShardOf() diverge once it grows
+     */
+    template<typename T>
+    class Sharded
+    {
+        static_assert(std::is_base_of_v<Object, T>, "T must be Object");
     private:
-        std::unordered_map<Address, Handler, AddressHash> m_Handlers;
-        mutable std::shared_mutex m_Mutex;
-        std::shared_ptr<WeakFlag> m_weakFlag;
-    private:
-        void AddHandler(const Address &address, const Handler &handler)
+        struct Shard
         {
-            std::unique_lock<std::shared_mutex> lock(m_Mutex);
-            if (!m_Handlers.count(address))
+            T *instance = nullptr;
+            EventLoop *loop = nullptr;
+            std::thread::id id;
+        };
+        std::vector<Shard> m_Shards;
+
+    public:
+        Sharded(const Sharded &) = delete;
+        Sharded &operator=(const Sharded &) = delete;
+
+        template<typename ...Args>
+        explicit Sharded(EventLoopGroup &group, const Args &... args)
+        {
+            m_Shards.resize(group.Size());
+            for (std::size_t i = 0; i < m_Shards.size(); ++i)
             {
-                m_Handlers.insert(std::make_pair(address, handler));
+                Shard &shard = m_Shards[i];
+                shard.loop = group.GetEventLoop(i);
+                shard.id = group.ThreadId(i);
+                shard.loop->SendEvent([&shard, &args...]()
+                {
+                    shard.instance = new T(args...);
+                });
             }
         }
 
-        void RemoveHandler(const Address &address)
+        ~Sharded()
         {
-            std::unique_lock<std::shared_mutex> lock(m_Mutex);
-            if (m_Handlers.count(address))
+            for (auto &shard: m_Shards)
             {
-                m_Handlers.erase(address);
+                T *instance = shard.instance;
+                shard.loop->SendEvent([instance]()
+                {
+                    delete instance;
+                });
             }
         }
 
-        template<typename T, typename U, typename ...SlotArgs>
-        Address ImitationFunctionHelper(T *object, U &&t, void(std::decay_t<U>::* func)(SlotArgs...), ConnectionType type)
+        std::size_t Size() const noexcept
         {
-            constexpr bool is_object_v = Implementation::is_object<T,std::thread::id>::value;
-            Address address = Address(object, func);
-            Handler v_handler;
-            v_handler.id = std::this_thread::get_id();
-            v_handler.handler = std::make_shared<Implementation::EventHandler<void, std::tuple<SlotArgs...>, Args...>>(std::forward<U>(t));
-            v_handler.type = type;
-            if constexpr (is_object_v)
+            return m_Shards.size();
+        }
+
+        std::size_t IndexOf(std::size_t hash) const noexcept
+        {
+            return Implementation::JumpConsistentHash(hash, m_Shards.size());
+        }
+
+        template<typename Key>
+        std::size_t ShardOf(const Key &key) const noexcept
+        {
+            return IndexOf(std::hash<Key>{}(key));
+        }
+
+        T *Local() const noexcept
+        {
+            for (auto &shard: m_Shards)
             {
-                v_handler.id = object->ThreadId();
+                if (shard.id == std::this_thread::get_id())
+                {
+                    return shard.instance;
+                }
             }
-            AddHandler(address, v_handler);
-            return address;
+            return nullptr;
         }
 
-        template<typename T, typename U, typename ...SlotArgs>
-        Address ImitationFunctionHelper(T *object, U &&t, void(std::decay_t<U>::* func)(SlotArgs...) const, ConnectionType type)
+        template<typename Callable>
+        void InvokeOnShard(std::size_t index, Callable &&func)
         {
-            constexpr bool is_object_v = Implementation::is_object<T,std::thread::id>::value;
-            Address address = Address(object, func);
-            Handler v_handler;
-            v_handler.id = std::this_thread::get_id();
-            v_handler.handler = std::make_shared<Implementation::EventHandler<void, std::tuple<SlotArgs...>, Args...>>(std::forward<U>(t));
-            v_handler.type = type;
-            if constexpr (is_object_v)
+            Shard &shard = m_Shards[index];
+            if (shard.id == std::this_thread::get_id())
             {
-                v_handler.id = object->ThreadId();
+                func(*shard.instance);
+                return;
+            }
+            T *instance = shard.instance;
+            shard.loop->PostEvent([instance, func = std::forward<Callable>(func)]() mutable
+            {
+                func(*instance);
+            });
+        }
+
+        template<typename Key, typename Callable>
+        void InvokeOnKey(const Key &key, Callable &&func)
+        {
+            InvokeOnShard(ShardOf(key), std::forward<Callable>(func));
+        }
+
+        /**
+         * @brief run func on every shard, then hand all results to done on the caller's loop
+         * - each shard writes its own cache line sized slot, done receives the results in shard order
+         * - when func returns void done is called without arguments
+         * - done runs on the shard that finished last when the caller has no event loop
+         */
+        template<typename Callable, typename Done>
+        void InvokeOnAll(Callable &&func, Done &&done)
+        {
+            using Result = std::decay_t<std::invoke_result_t<Callable &, T &>>;
+            constexpr static std::size_t CacheLineSize = 64;
+            struct alignas(CacheLineSize) Slot
+            {
+                std::optional<std::conditional_t<std::is_void_v<Result>, bool, Result>> value;
+            };
+            struct State
+            {
+                std::vector<Slot> slots;
+                std::atomic<std::size_t> remaining;
+                std::decay_t<Callable> func;
+                std::decay_t<Done> done;
+                EventLoop *caller;
+
+                void Finish()
+                {
+                    if constexpr (std::is_void_v<Result>)
+                    {
+                        done();
+                    }
+                    else
+                    {
+                        std::vector<Result> results;
+                        results.reserve(slots.size());
+                        for (auto &slot: slots)
+                        {
+                            results.push_back(std::move(*slot.value));
+                        }
+                        done(std::move(results));
+                    }
+                }
+            };
+            auto state = std::shared_ptr<State>(new State{ std::vector<Slot>(m_Shards.size()), m_Shards.size(),
+                std::forward<Callable>(func), std::forward<Done>(done), winSignal::GetEventLoop(std::this_thread::get_id()) });
+            for (std::size_t i = 0; i < m_Shards.size(); ++i)
+            {
+                T *instance = m_Shards[i].instance;
+                m_Shards[i].loop->PostEvent([state, instance, i]()
+                {
+                    if constexpr (std::is_void_v<Result>)
+                    {
+                        state->func(*instance);
+                    }
+                    else
+                    {
+                        state->slots[i].value.emplace(state->func(*instance));
+                    }
+                    if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    {
+                        return;
+                    }
+                    if (state->caller != nullptr)
+                    {
+                        state->caller->PostEvent([state]()
+                        {
+                            state->Finish();
+                        });
+                    }
+                    else
+                    {
+                        state->Finish();
+                    }
+                });
+            }
+        }
+
+        template<typename Callable>
+        void InvokeOnAll(Callable &&func)
+        {
+            for (std::size_t i = 0; i < m_Shards.size(); ++i)
+            {
+                InvokeOnShard(i, func);
+            }
+        }
+    };
+
+
+    /**
+     * @brief serial task queue that runs on one loop at a time and can be moved between loops
+     * - tasks of a strand never run concurrently and keep their posting order across moves
+     */
+    class Strand
+    {
+    private:
+        std::mutex m_Mutex;
+        std::deque<std::function<void()>> m_Tasks;
+        EventLoop *m_Loop = nullptr;
+        bool m_Scheduled = false;
+        std::weak_ptr<Strand> m_Self;
+
+    private:
+        void Schedule()
+        {
+            m_Scheduled = true;
+            m_Loop->PostEvent([self = m_Self.lock(), loop = m_Loop]()
+            {
+                self->Drain(loop);
+            });
+        }
+
+        /**
+         * @brief run the tasks queued when the drain started, unless the strand is moved to another loop first
+         * - tasks posted meanwhile wait for the next drain, so a busy strand yields its loop between batches
+         * - a moved strand continues its backlog on the new loop instead of finishing it here
+         */
+        void Drain(EventLoop *loop)
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            for (std::size_t count = m_Tasks.size(); count > 0 && m_Loop == loop; --count)
+            {
+                std::function<void()> func = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+                lock.unlock();
+                func();
+                lock.lock();
+            }
+            if (m_Tasks.empty())
+            {
+                m_Scheduled = false;
+            }
+            else
+            {
+                Schedule();
             }
-            AddHandler(address, v_handler);
-            return address;
         }
 
     public:
-        Signal()
+        Strand(const Strand &) = delete;
+        Strand &operator=(const Strand &) = delete;
+
+        explicit Strand(EventLoop *loop) noexcept : m_Loop(loop)
         {
-            m_weakFlag = std::make_shared<WeakFlag>();
         }
-        ~Signal()
+
+        static std::shared_ptr<Strand> Create(EventLoop *loop)
         {
-            m_Handlers.clear();
+            auto strand = std::make_shared<Strand>(loop);
+            strand->m_Self = strand;
+            return strand;
         }
 
-        std::weak_ptr<WeakFlag> GetWeakFlag()
+        template<typename Callable>
+        void Post(Callable &&func)
         {
-            return std::weak_ptr<WeakFlag>(m_weakFlag);
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Tasks.emplace_back(std::forward<Callable>(func));
+            if (!m_Scheduled)
+            {
+                Schedule();
+            }
         }
 
-        void Emit(const Args &... args)
+        EventLoop *GetEventLoop()
         {
-            std::shared_lock<std::shared_mutex> lock(m_Mutex);
-            for (auto &&element: m_Handlers)
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            return m_Loop;
+        }
+
+        void MoveToLoop(EventLoop *loop)
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Loop = loop;
+        }
+    };
+
+    /**
+     * @brief loop pool that adds threads while dispatch lags and retires threads that stay idle
+     * - a monitor thread samples every loop's queue depth and oldest pending post
+     * - strands are redistributed whenever the thread count changes
+     */
+    class ElasticLoopPool
+    {
+    public:
+        struct Options
+        {
+            std::size_t minThreads = 1;
+            std::size_t maxThreads = std::thread::hardware_concurrency();
+            std::chrono::milliseconds sampleInterval{ 50 };
+            std::chrono::milliseconds growLag{ 10 };
+            std::size_t growDepth = 256;
+            std::size_t shrinkIdleSamples = 40;
+        };
+
+    private:
+        struct Member
+        {
+            std::unique_ptr<EventLoopObject> object;
+            EventLoop *loop = nullptr;
+            std::size_t idleSamples = 0;
+        };
+
+    private:
+        Options m_Options;
+        std::vector<Member> m_Members;
+        std::vector<std::weak_ptr<Strand>> m_Strands;
+        std::atomic<std::size_t> m_NextLoop = 0;
+        std::atomic<int64_t> m_MaxLagMicroseconds = 0;
+        mutable std::shared_mutex m_Mutex;
+        std::mutex m_MonitorMutex;
+        std::condition_variable m_MonitorCondition;
+        bool m_Stop = false;
+        std::thread m_Monitor;
+
+    private:
+        static Member CreateMember()
+        {
+            Member member;
+            member.object = std::make_unique<EventLoopObject>();
+            member.loop = member.object->GetEventLoop();
+            return member;
+        }
+
+        void Grow()
+        {
+            m_Members.push_back(CreateMember());
+            std::size_t count = m_Members.size();
+            std::size_t index = 0;
+            for (auto iter = m_Strands.begin(); iter != m_Strands.end();)
+            {
+                auto strand = iter->lock();
+                if (!strand)
+                {
+                    iter = m_Strands.erase(iter);
+                    continue;
+                }
+                if (index++ % count == count - 1)
+                {
+                    strand->MoveToLoop(m_Members.back().loop);
+                }
+                ++iter;
+            }
+        }
+
+        std::unique_ptr<EventLoopObject> Shrink(std::size_t victim)
+        {
+            EventLoop *retired = m_Members[victim].loop;
+            std::unique_ptr<EventLoopObject> object = std::move(m_Members[victim].object);
+            m_Members.erase(m_Members.begin() + victim);
+            std::size_t next = 0;
+            for (auto iter = m_Strands.begin(); iter != m_Strands.end();)
+            {
+                auto strand = iter->lock();
+                if (!strand)
+                {
+                    iter = m_Strands.erase(iter);
+                    continue;
+                }
+                if (strand->GetEventLoop() == retired)
+                {
+                    strand->MoveToLoop(m_Members[next++ % m_Members.size()].loop);
+                }
+                ++iter;
+            }
+            return object;
+        }
+
+        void Sample()
+        {
+            std::unique_ptr<EventLoopObject> retired;
+            std::size_t count = 0;
             {
-                switch (element.second.type)
+                std::unique_lock<std::shared_mutex> lock(m_Mutex);
+                std::chrono::steady_clock::duration maxLag{};
+                std::size_t depth = 0;
+                std::size_t idle = m_Members.size();
+                for (std::size_t i = 0; i < m_Members.size(); ++i)
                 {
-                    case ConnectionType::AutoConnection:
+                    auto &member = m_Members[i];
+                    std::size_t pending = member.loop->PendingCount();
+                    maxLag = (std::max)(maxLag, member.loop->DispatchLag());
+                    depth += pending;
+                    member.idleSamples = pending == 0 ? member.idleSamples + 1 : 0;
+                    if (member.idleSamples >= m_Options.shrinkIdleSamples && idle == m_Members.size())
                     {
-                        if (element.second.id == std::this_thread::get_id())
-                        {
-                            (*element.second.handler)(args...);
-                        }
-                        else
-                        {
-                            EventLoop *loop = Implementation::EventLoopManager::GetInstance()->GetEventLoop(element.second.id);
-                            if (loop != nullptr)
-                            {
-                                loop->PostEvent([handler = element.second.handler, args...]
-                                {
-                                    (*handler)(args...);
-                                });
-                            }
-                        }
-                        break;
-                    }
-                    case ConnectionType::DirectConnection:
-                    {
-                        (*element.second.handler)(args...);
-                        break;
-                    }
-                    case ConnectionType::QueuedConnection:
-                    {
-                        EventLoop *loop = Implementation::EventLoopManager::GetInstance()->GetEventLoop(element.second.id);
-                        if (loop != nullptr)
-                        {
-                            loop->PostEvent([handler = element.second.handler, args...]
-                            {
-                                (*handler)(args...);
-                            });
-                        }
-                        break;
+                        idle = i;
                     }
-                    case ConnectionType::BlockingQueuedConnection:
+                }
+                m_MaxLagMicroseconds.store(std::chrono::duration_cast<std::chrono::microseconds>(maxLag).count(), std::memory_order_relaxed);
+
+                bool overloaded = maxLag > m_Options.growLag || depth > m_Options.growDepth * m_Members.size();
+                if (overloaded && m_Members.size() < m_Options.maxThreads)
+                {
+                    Grow();
+                    count = m_Members.size();
+                }
+                else if (!overloaded && idle < m_Members.size() && m_Members.size() > m_Options.minThreads)
+                {
+                    retired = Shrink(idle);
+                    for (auto &member: m_Members)
                     {
-                        EventLoop *loop = Implementation::EventLoopManager::GetInstance()->GetEventLoop(element.second.id);
-                        if (loop != nullptr)
-                        {
-                            loop->SendEvent([handler = element.second.handler, args...]
-                            {
-                                (*handler)(args...);
-                            });
-                        }
-                        break;
+                        member.idleSamples = 0;
                     }
+                    count = m_Members.size();
                 }
             }
+            if (count != 0)
+            {
+                resized.Emit(count);
+            }
         }
 
     public:
-        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...), ConnectionType type);
+        ElasticLoopPool(const ElasticLoopPool &) = delete;
+        ElasticLoopPool &operator=(const ElasticLoopPool &) = delete;
 
-        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...));
+        ElasticLoopPool() : ElasticLoopPool(Options())
+        {
+        }
 
-        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...) const, ConnectionType type);
+        explicit ElasticLoopPool(const Options &options) : m_Options(options)
+        {
+            m_Options.minThreads = (std::max)(m_Options.minThreads, static_cast<std::size_t>(1));
+            m_Options.maxThreads = (std::max)(m_Options.maxThreads, m_Options.minThreads);
+            for (std::size_t i = 0; i < m_Options.minThreads; ++i)
+            {
+                m_Members.push_back(CreateMember());
+            }
+            m_Monitor = std::thread([this]()
+            {
+                std::unique_lock<std::mutex> lock(m_MonitorMutex);
+                while (!m_MonitorCondition.wait_for(lock, m_Options.sampleInterval, [this]() { return m_Stop; }))
+                {
+                    lock.unlock();
+                    Sample();
+                    lock.lock();
+                }
+            });
+        }
 
-        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...) const);
+        ~ElasticLoopPool()
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_MonitorMutex);
+                m_Stop = true;
+            }
+            m_MonitorCondition.notify_all();
+            m_Monitor.join();
+        }
 
-        template<typename Sender, typename Receiver, typename T, typename Lambda, typename ...SignalArgs>
-        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, Lambda &&lambda, ConnectionType type);
+        std::size_t ThreadCount() const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            return m_Members.size();
+        }
 
-        template<typename Sender, typename T, typename Lambda, typename ...SignalArgs>
-        friend constexpr void Connect(Sender* sender, Signal<SignalArgs...> T::* event, Lambda&& lambda);
+        std::chrono::microseconds MaxDispatchLag() const noexcept
+        {
+            return std::chrono::microseconds(m_MaxLagMicroseconds.load(std::memory_order_relaxed));
+        }
 
-        template<typename Sender, typename T, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, void(*handler)(SlotArgs...));
+        template<typename Callable>
+        void Post(Callable &&func)
+        {
+            std::shared_lock<std::shared_mutex> lock(m_Mutex);
+            std::size_t index = m_NextLoop.fetch_add(1, std::memory_order_relaxed) % m_Members.size();
+            m_Members[index].loop->PostEvent(std::forward<Callable>(func));
+        }
 
-        template<typename Sender, typename T, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, void(*handler)(SlotArgs...));
+        std::shared_ptr<Strand> CreateStrand()
+        {
+            std::unique_lock<std::shared_mutex> lock(m_Mutex);
+            std::size_t index = m_NextLoop.fetch_add(1, std::memory_order_relaxed) % m_Members.size();
+            auto strand = Strand::Create(m_Members[index].loop);
+            m_Strands.push_back(strand);
+            return strand;
+        }
 
+    public:
+        winSignal::Signal<std::size_t> resized;
     };
 
 
-    class WeakFlag
+    /**
+     * @brief drives an event loop at a fixed tick rate
+     * - tick is emitted on the loop thread once per frame with the frame index and the time since the previous tick
+     * - frameFinished carries the timing of every completed frame, including overrun and skipped tick counters
+     */
+    class FrameScheduler : public Object
     {
+    private:
+        EventLoop *m_Loop = nullptr;
+        FrameOptions m_Options;
+        std::chrono::steady_clock::time_point m_LastTick;
 
-    };
+    public:
+        explicit FrameScheduler(EventLoop *loop, const FrameOptions &options = FrameOptions()) : m_Loop(loop), m_Options(options)
+        {
+            MoveToThread(loop->ThreadId());
+        }
 
-    class Object
-    {
-    private:
-        using Address = Implementation::Address;
-        using AddressHash = Implementation::AddressHash;
-        using ClassFunctionPointer = Implementation::ClassFunctionPointer;
-        using Connection = std::map<ClassFunctionPointer, std::function<void()>>;
-    private:
-        std::atomic<std::thread::id> m_Id;
-        std::unordered_map<Address, Connection, AddressHash> m_SendersList;
-        std::unordered_map<Address, std::function<void()>, AddressHash> m_ReceiversList;
-        mutable std::shared_mutex m_Mutex;
-        std::shared_ptr<WeakFlag> m_weakFlag;
-    private:
-        template<typename Callable>
-        void AddSender(const Address &senderAddress, const ClassFunctionPointer &functionAddress, Callable &&func)
+        ~FrameScheduler()
         {
-            std::unique_lock<std::shared_mutex> lock(m_Mutex);
-            m_SendersList[senderAddress].insert(std::make_pair(functionAddress, std::forward<Callable>(func)));
+            Stop();
         }
 
-        template<typename Callable>
-        void AddReceiver(const Address &receiverAddress, Callable &&func)
+        void Start()
         {
-            std::unique_lock<std::shared_mutex> lock(m_Mutex);
-            m_ReceiversList[receiverAddress] = std::forward<Callable>(func);
+            m_Loop->SetFrameMode(m_Options, [this](const FrameStats &stats)
+            {
+                auto now = std::chrono::steady_clock::now();
+                auto delta = stats.frame == 0 ? m_Options.period : now - m_LastTick;
+                m_LastTick = now;
+                tick.Emit(stats.frame, std::chrono::duration_cast<std::chrono::nanoseconds>(delta));
+            }, [this](const FrameStats &stats)
+            {
+                frameFinished.Emit(stats);
+            });
         }
 
-        void RemoveSender(const Address &senderAddress, const ClassFunctionPointer &functionAddress)
+        void Stop()
         {
-            std::unique_lock<std::shared_mutex> lock(m_Mutex);
-            m_SendersList.at(senderAddress).erase(functionAddress);
+            m_Loop->ClearFrameMode();
         }
 
-        void RemoveReceiver(const Address &address)
+    public:
+        Signal<uint64_t, std::chrono::nanoseconds> tick;
+        Signal<FrameStats> frameFinished;
+    };
+
+    /**
+     * @brief long running work split into slices that yield back to the event loop
+     * - step performs one unit of work and returns false once everything is done
+     * - a slice runs steps until the loop's slice budget is spent, the number of steps between clock reads adapts to their cost
+     * - between slices the task is re-queued behind pending events and due timers are dispatched
+     */
+    class CooperativeTask : public Object
+    {
+    private:
+        EventLoop *m_Loop = nullptr;
+        std::function<bool()> m_Step;
+        std::weak_ptr<CooperativeTask> m_Self;
+        std::atomic<bool> m_Started = false;
+        std::atomic<bool> m_Cancelled = false;
+        std::atomic<bool> m_Finished = false;
+        std::atomic<uint64_t> m_Steps = 0;
+        std::size_t m_Batch = 1;
+
+        // only Create can construct a task, so m_Self is always set before it is scheduled
+        struct Passkey
         {
-            std::unique_lock<std::shared_mutex> lock(m_Mutex);
-            m_ReceiversList.erase(address);
+            explicit Passkey() = default;
+        };
+
+    private:
+        void Schedule()
+        {
+            m_Loop->PostEvent(static_cast<const Object *>(this), [self = m_Self.lock()]()
+            {
+                self->RunSlice();
+            });
         }
 
-        bool ContainSender(const Address &address) const
+        void RunSlice()
         {
-            std::shared_lock<std::shared_mutex> lock(m_Mutex);
-            return m_SendersList.count(address);
+            if (m_Cancelled.load(std::memory_order_relaxed))
+            {
+                Finish(false);
+                return;
+            }
+            using Clock = std::chrono::steady_clock;
+            auto budget = m_Loop->SliceBudget();
+            auto start = Clock::now();
+            uint64_t steps = m_Steps.load(std::memory_order_relaxed);
+            bool more = true;
+            while (more)
+            {
+                auto batchStart = Clock::now();
+                std::size_t done = 0;
+                while (done < m_Batch && more)
+                {
+                    more = m_Step();
+                    ++done;
+                }
+                steps += done;
+                auto now = Clock::now();
+                auto cost = (now - batchStart) / done;
+                auto target = budget / 4;
+                std::size_t batch = cost.count() > 0 ? static_cast<std::size_t>(target / cost) : m_Batch * 2;
+                m_Batch = (std::min)((std::max)(batch, static_cast<std::size_t>(1)), static_cast<std::size_t>(1) << 20);
+                if (now - start >= budget || m_Cancelled.load(std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            m_Steps.store(steps, std::memory_order_relaxed);
+            progress.Emit(steps);
+            if (!more)
+            {
+                Finish(true);
+                return;
+            }
+            m_Loop->DispatchDueTimers();
+            Schedule();
         }
 
-        bool ContainReceiver(const Address &address) const
+        void Finish(bool completed)
         {
-            std::shared_lock<std::shared_mutex> lock(m_Mutex);
-            return m_ReceiversList.count(address);
+            m_Step = nullptr;
+            m_Finished.store(true, std::memory_order_release);
+            finished.Emit(m_Steps.load(std::memory_order_relaxed), completed);
         }
 
     public:
-        template<typename Callable>
-        friend void Implementation::AddSender(Object &object, const Address &senderAddress, const ClassFunctionPointer &functionAddress, Callable &&func);
-
-        template<typename Callable>
-        friend void Implementation::AddReceiver(Object &object, const Address &receiverAddress, Callable &&func);
-
-        friend void Implementation::RemoveSender(Object &object, const Address &senderAddress, const ClassFunctionPointer &functionAddress);
-
-        friend void Implementation::RemoveReceiver(Object &object, const Address &address);
-
-        friend bool Implementation::ContainSender(const Object &object, const Address &address);
-
-        friend bool Implementation::ContainReceiver(const Object &object, const Address &address);
+        CooperativeTask(const CooperativeTask &) = delete;
+        CooperativeTask &operator=(const CooperativeTask &) = delete;
 
-        Object()
+        CooperativeTask(Passkey, EventLoop *loop, std::function<bool()> step) : m_Loop(loop), m_Step(std::move(step))
         {
-            m_Id = std::this_thread::get_id();
-            m_weakFlag = std::make_shared<WeakFlag>();
+            MoveToThread(loop->ThreadId());
         }
 
-        virtual ~Object()
+        static std::shared_ptr<CooperativeTask> Create(EventLoop *loop, std::function<bool()> step)
         {
-            DisconnectAll();
+            auto task = std::make_shared<CooperativeTask>(Passkey(), loop, std::move(step));
+            task->m_Self = task;
+            return task;
         }
 
-        std::weak_ptr<WeakFlag> GetWeakFlag() noexcept
+        /**
+         * @brief queue the first slice - calls after the first one do nothing
+         */
+        void Start()
         {
-            return std::weak_ptr<WeakFlag>(m_weakFlag);
+            if (!m_Started.exchange(true, std::memory_order_relaxed))
+            {
+                Schedule();
+            }
         }
 
-        void MoveToThread(const std::thread &target) noexcept
+        void Cancel() noexcept
         {
-            m_Id = target.get_id();
+            m_Cancelled.store(true, std::memory_order_relaxed);
         }
 
-        void MoveToThread(const std::thread::id &id) noexcept
+        bool IsFinished() const noexcept
         {
-            m_Id = id;
+            return m_Finished.load(std::memory_order_acquire);
         }
 
-        void MoveToThread(const Thread &other) noexcept
+        uint64_t Steps() const noexcept
         {
-            m_Id = other.GetID();
+            return m_Steps.load(std::memory_order_relaxed);
         }
 
-        std::thread::id ThreadId() const noexcept
+    public:
+        Signal<uint64_t> progress;
+        Signal<uint64_t, bool> finished;
+    };
+
+    namespace Implementation
+    {
+        /**
+         * @brief process wide worker pool shared by the parallel helpers
+         * - every worker owns a deque, it pops its own work from the back and steals from the front of the others
+         */
+        class WorkStealingPool
         {
-            return m_Id;
-        }
+        private:
+            struct Worker
+            {
+                std::mutex mutex;
+                std::deque<std::function<void()>> tasks;
+            };
+
+            std::vector<std::unique_ptr<Worker>> m_Workers;
+            std::vector<std::thread> m_Threads;
+            std::mutex m_Mutex;
+            std::condition_variable m_Wake;
+            std::atomic<std::size_t> m_Pending = 0;
+            std::atomic<std::size_t> m_NextWorker = 0;
+            bool m_Stop = false;
+
+            static std::size_t &CurrentIndex() noexcept
+            {
+                thread_local std::size_t index = static_cast<std::size_t>(-1);
+                return index;
+            }
+
+            struct Sizing
+            {
+                std::mutex mutex;
+                std::size_t count = 0;
+                bool created = false;
+            };
+
+            static Sizing &GetSizing()
+            {
+                static Sizing sizing;
+                return sizing;
+            }
+
+            WorkStealingPool()
+            {
+                std::size_t count = (std::max)(std::thread::hardware_concurrency(), 2u) - 1;
+                {
+                    Sizing &sizing = GetSizing();
+                    std::unique_lock<std::mutex> lock(sizing.mutex);
+                    count = sizing.count != 0 ? sizing.count : count;
+                    sizing.created = true;
+                }
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    m_Workers.push_back(std::make_unique<Worker>());
+                }
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    m_Threads.emplace_back([this, i]()
+                    {
+                        CurrentIndex() = i;
+                        WorkerLoop(i);
+                    });
+                }
+            }
+
+            ~WorkStealingPool()
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    m_Stop = true;
+                }
+                m_Wake.notify_all();
+                for (auto &thread: m_Threads)
+                {
+                    thread.join();
+                }
+            }
+
+            bool PopLocal(std::size_t index, std::function<void()> &task)
+            {
+                Worker &worker = *m_Workers[index];
+                std::unique_lock<std::mutex> lock(worker.mutex);
+                if (worker.tasks.empty())
+                {
+                    return false;
+                }
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+                return true;
+            }
+
+            bool Steal(std::size_t index, std::function<void()> &task)
+            {
+                for (std::size_t offset = 1; offset < m_Workers.size(); ++offset)
+                {
+                    Worker &victim = *m_Workers[(index + offset) % m_Workers.size()];
+                    std::unique_lock<std::mutex> lock(victim.mutex);
+                    if (!victim.tasks.empty())
+                    {
+                        task = std::move(victim.tasks.front());
+                        victim.tasks.pop_front();
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void WorkerLoop(std::size_t index)
+            {
+                for (;;)
+                {
+                    std::function<void()> task;
+                    if (PopLocal(index, task) || Steal(index, task))
+                    {
+                        m_Pending.fetch_sub(1, std::memory_order_acq_rel);
+                        task();
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    m_Wake.wait(lock, [this]()
+                    {
+                        return m_Stop || m_Pending.load(std::memory_order_acquire) != 0;
+                    });
+                    if (m_Stop && m_Pending.load(std::memory_order_acquire) == 0)
+                    {
+                        return;
+                    }
+                }
+            }
+
+        public:
+            WorkStealingPool(const WorkStealingPool &) = delete;
+            WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+            static WorkStealingPool *GetInstance()
+            {
+                static WorkStealingPool instance;
+                return &instance;
+            }
+
+            static bool SetWorkerCount(std::size_t count)
+            {
+                Sizing &sizing = GetSizing();
+                std::unique_lock<std::mutex> lock(sizing.mutex);
+                if (sizing.created)
+                {
+                    return false;
+                }
+                sizing.count = count;
+                return true;
+            }
+
+            std::size_t Size() const noexcept
+            {
+                return m_Workers.size();
+            }
+
+            /**
+             * @brief queue count tasks, task(i) runs for every i in [0, count)
+             * - a worker submitting keeps the tasks in its own deque for the others to steal, other threads spread them round robin
+             */
+            template<typename Task>
+            void Submit(std::size_t count, const Task &task)
+            {
+                std::size_t self = CurrentIndex();
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    std::size_t target = self < m_Workers.size() ? self : m_NextWorker.fetch_add(1, std::memory_order_relaxed) % m_Workers.size();
+                    {
+                        std::unique_lock<std::mutex> lock(m_Workers[target]->mutex);
+                        m_Workers[target]->tasks.emplace_back([task, i]()
+                        {
+                            task(i);
+                        });
+                    }
+                    m_Pending.fetch_add(1, std::memory_order_release);
+                }
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                }
+                if (count == 1)
+                {
+                    m_Wake.notify_one();
+                }
+                else
+                {
+                    m_Wake.notify_all();
+                }
+            }
+        };
 
-        winSignal::EventLoop* GetEventLoop() noexcept
+        struct ParallelRange
         {
-           return winSignal::GetEventLoop(m_Id);
-        }
+            std::size_t size = 0;
+            std::size_t chunks = 0;
 
-        template<typename Callable>
-        void InvokeMethod(Callable&& func, winSignal::ConnectionType type = ConnectionType::AutoConnection)
+            explicit ParallelRange(std::size_t count) noexcept : size(count)
+            {
+                chunks = (std::min)(count, WorkStealingPool::GetInstance()->Size() * 4);
+            }
+
+            std::size_t Begin(std::size_t chunk) const noexcept
+            {
+                return size * chunk / chunks;
+            }
+
+            std::size_t End(std::size_t chunk) const noexcept
+            {
+                return size * (chunk + 1) / chunks;
+            }
+        };
+
+        template<typename Chunk, typename Complete>
+        void RunChunks(std::size_t count, Chunk &&chunk, Complete &&complete)
         {
-            switch (type)
+            if (count == 0)
             {
-            case ConnectionType::AutoConnection:
+                complete();
+                return;
+            }
+            struct State
             {
-                if (m_Id == std::this_thread::get_id())
+                std::atomic<std::size_t> remaining;
+                std::decay_t<Chunk> chunk;
+                std::decay_t<Complete> complete;
+
+                State(std::size_t count, Chunk &&chunk, Complete &&complete)
+                    : remaining(count), chunk(std::forward<Chunk>(chunk)), complete(std::forward<Complete>(complete))
                 {
-                    func();
                 }
-                else if (EventLoop* loop = GetEventLoop())
+            };
+            auto state = std::make_shared<State>(count, std::forward<Chunk>(chunk), std::forward<Complete>(complete));
+            WorkStealingPool::GetInstance()->Submit(count, [state](std::size_t index)
+            {
+                state->chunk(index);
+                if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
                 {
-                    loop->PostEvent([=]() {
-                        func();
-                    });
+                    state->complete();
                 }
-                break;
-            }
-            case ConnectionType::DirectConnection:
-            {
-                func();
-                break;
-            }
-            case ConnectionType::QueuedConnection:
+            });
+        }
+
+        template<typename Callable>
+        std::function<void()> ContinueOnCaller(Callable &&func)
+        {
+            EventLoop *loop = GetEventLoop(std::this_thread::get_id());
+            return [loop, func = std::forward<Callable>(func)]() mutable
             {
-                if (EventLoop* loop = GetEventLoop())
+                if (loop != nullptr)
                 {
-                    loop->PostEvent([=]() {
-                        func();
-                    });
+                    loop->PostEvent(std::move(func));
                 }
-                break;
-            }
-            case ConnectionType::BlockingQueuedConnection:
-            {
-                if (EventLoop* loop = GetEventLoop())
+                else
                 {
-                    loop->SendEvent([=]() {
-                        func();
-                    });
-                    break;
+                    func();
                 }
-            }
-            }
+            };
         }
 
-        void DisconnectAll()
+        template<typename RandomIt, typename Compare>
+        void MergeRuns(RandomIt first, Compare comp, std::shared_ptr<std::vector<std::size_t>> bounds, std::function<void()> done)
         {
-            std::unordered_map<Address, Connection, AddressHash> sendersList;
-            std::unordered_map<Address, std::function<void()>, AddressHash> receiversList;
+            if (bounds->size() <= 2)
             {
-                std::shared_lock<std::shared_mutex> lock(m_Mutex);
-                sendersList = m_SendersList;
-                receiversList = m_ReceiversList;
+                done();
+                return;
             }
-            for (auto& pair : sendersList)
+            std::size_t pairs = (bounds->size() - 1) / 2;
+            RunChunks(pairs, [first, comp, bounds](std::size_t pair)
             {
-                for (auto& func : pair.second)
+                auto &runs = *bounds;
+                std::inplace_merge(first + runs[pair * 2], first + runs[pair * 2 + 1], first + runs[pair * 2 + 2], comp);
+            }, [first, comp, bounds, done]()
+            {
+                auto next = std::make_shared<std::vector<std::size_t>>();
+                for (std::size_t i = 0; i < bounds->size(); i += 2)
                 {
-                    func.second();
+                    next->push_back((*bounds)[i]);
                 }
-            }
-            for (auto& receiver : receiversList)
+                if (next->back() != bounds->back())
+                {
+                    next->push_back(bounds->back());
+                }
+                MergeRuns(first, comp, next, done);
+            });
+        }
+    }
+
+    /**
+     * @brief set the number of workers in the pool shared by ParallelFor, ParallelReduce and ParallelSort
+     * - 0 restores the default of one less than the hardware threads, at least one
+     * - only works before the first parallel call starts the pool, returns false afterwards
+     */
+    inline bool SetParallelWorkerCount(std::size_t count)
+    {
+        return Implementation::WorkStealingPool::SetWorkerCount(count);
+    }
+
+    /**
+     * @brief run body(i) for every i in [first, last) on the shared worker pool
+     * - done is posted to the calling thread's event loop once every index has been processed
+     * - on a thread without an event loop done runs on the worker that finishes the last chunk, or right away for an empty range
+     * - the call never blocks, indices are split into chunks that idle workers steal
+     */
+    template<typename Index, typename Body, typename Done>
+    void ParallelFor(Index first, Index last, Body &&body, Done &&done)
+    {
+        auto finish = Implementation::ContinueOnCaller(std::forward<Done>(done));
+        if (!(first < last))
+        {
+            finish();
+            return;
+        }
+        Implementation::ParallelRange range(static_cast<std::size_t>(last - first));
+        Implementation::RunChunks(range.chunks, [first, range, body = std::forward<Body>(body)](std::size_t chunk)
+        {
+            for (std::size_t i = range.Begin(chunk); i < range.End(chunk); ++i)
             {
-                (receiver.second)();
+                body(static_cast<Index>(first + static_cast<Index>(i)));
             }
-        }
+        }, std::move(finish));
+    }
 
-        void DeleteLater()
+    /**
+     * @brief fold [first, last) with reduce on the shared worker pool and post the result to the calling loop
+     * - reduce must be associative, chunk results are combined in range order starting from init
+     * - on a thread without an event loop done runs on the worker that combines the results, or right away for an empty range
+     * - the range must stay alive until done runs
+     */
+    template<typename RandomIt, typename T, typename Reduce, typename Done>
+    void ParallelReduce(RandomIt first, RandomIt last, T init, Reduce &&reduce, Done &&done)
+    {
+        auto result = std::make_shared<std::optional<T>>();
+        auto finish = Implementation::ContinueOnCaller([result, done = std::forward<Done>(done)]() mutable
         {
-            DisconnectAll();
-            if (EventLoop* loop = GetEventLoop())
+            done(std::move(**result));
+        });
+        std::size_t size = static_cast<std::size_t>(std::distance(first, last));
+        if (size == 0)
+        {
+            *result = std::move(init);
+            finish();
+            return;
+        }
+        Implementation::ParallelRange range(size);
+        auto partials = std::make_shared<std::vector<std::optional<T>>>(range.chunks);
+        auto combine = std::make_shared<std::decay_t<Reduce>>(std::forward<Reduce>(reduce));
+        Implementation::RunChunks(range.chunks, [first, range, partials, combine](std::size_t chunk)
+        {
+            auto begin = first + range.Begin(chunk);
+            auto end = first + range.End(chunk);
+            T value = *begin;
+            for (++begin; begin != end; ++begin)
             {
-                loop->PostEvent([=]() {
-                    delete this;
-                });
+                value = (*combine)(std::move(value), *begin);
             }
-            else
+            (*partials)[chunk] = std::move(value);
+        }, [partials, combine, result, init = std::move(init), finish = std::move(finish)]() mutable
+        {
+            T value = std::move(init);
+            for (auto &partial: *partials)
             {
-                delete this;
+                value = (*combine)(std::move(value), std::move(*partial));
             }
-        }
-
-        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...), ConnectionType type);
-
-        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...));
-
-        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...) const, ConnectionType type);
-
-        template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void(U::* handler)(SlotArgs...) const);
-
-        template<typename Sender, typename Receiver, typename T, typename Lambda, typename ...SignalArgs>
-        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, Lambda &&lambda, ConnectionType type);
+            *result = std::move(value);
+            finish();
+        });
+    }
 
-        template<typename Sender, typename T, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, void(*handler)(SlotArgs...));
+    /**
+     * @brief sort [first, last) on the shared worker pool and post done to the calling loop
+     * - chunks are sorted in parallel, then merged pairwise in parallel rounds
+     * - on a thread without an event loop done runs on the worker that finishes the last merge, or right away for fewer than two elements
+     * - the range must stay alive and untouched until done runs
+     */
+    template<typename RandomIt, typename Compare, typename Done>
+    void ParallelSort(RandomIt first, RandomIt last, Compare comp, Done &&done)
+    {
+        std::function<void()> finish = Implementation::ContinueOnCaller(std::forward<Done>(done));
+        std::size_t size = static_cast<std::size_t>(std::distance(first, last));
+        if (size < 2)
+        {
+            finish();
+            return;
+        }
+        Implementation::ParallelRange range(size);
+        auto bounds = std::make_shared<std::vector<std::size_t>>();
+        for (std::size_t chunk = 0; chunk < range.chunks; ++chunk)
+        {
+            bounds->push_back(range.Begin(chunk));
+        }
+        bounds->push_back(size);
+        Implementation::RunChunks(range.chunks, [first, range, comp](std::size_t chunk)
+        {
+            std::sort(first + range.Begin(chunk), first + range.End(chunk), comp);
+        }, [first, comp, bounds, finish]()
+        {
+            Implementation::MergeRuns(first, comp, bounds, finish);
+        });
+    }
 
-        template<typename Sender, typename T, typename ...SignalArgs, typename ...SlotArgs>
-        friend constexpr void Disconnect(Sender *sender, Signal<SignalArgs...> T::* event, void(*handler)(SlotArgs...));
+    template<typename RandomIt, typename Done>
+    void ParallelSort(RandomIt first, RandomIt last, Done &&done)
+    {
+        ParallelSort(first, last, std::less<>(), std::forward<Done>(done));
+    }
 
-    };
+    /**
+     * @brief iteration scoped memory resource of the event loop running on the calling thread
+     * - falls back to the default resource on threads without an event loop
+     * - see EventLoop::FrameResource for the lifetime rules
+     */
+    inline std::pmr::memory_resource *FrameResource() noexcept
+    {
+        Implementation::FrameArena *arena = Implementation::FrameArena::Current();
+        return arena != nullptr ? static_cast<std::pmr::memory_resource *>(arena) : std::pmr::get_default_resource();
+    }
 
-    class EventLoopObject : public Object
+    /**
+     * @brief one lazily created T per event loop
+     * - Get returns the instance of the loop running on the calling thread without any locking
+     * - instances are destroyed in reverse order of their creation on that loop when the loop shuts down
+     * - threads without an event loop get a per-thread instance released at thread exit
+     * - the slot of a destroyed LoopLocal is reused, instances it left on a loop are released there
+     *   when the slot is next used on that loop or when the loop shuts down
+     */
+    template<typename T>
+    class LoopLocal
     {
     private:
-        winSignal::Thread* m_pThread = nullptr;
+        Implementation::LoopLocalStorage::Slot m_Slot = Implementation::LoopLocalStorage::NewSlot();
+        std::function<T()> m_Factory;
 
-    public:
-        EventLoopObject()
+        static Implementation::LoopLocalStorage &Storage()
         {
-            m_pThread = new winSignal::Thread([=]()
-            {
-                winSignal::EventLoop eventLoop;
-                eventLoop.Run();
-            });
-            MoveToThread(*m_pThread);
+            Implementation::LoopLocalStorage *storage = Implementation::LoopLocalStorage::Current();
+            return storage != nullptr ? *storage : Implementation::LoopLocalStorage::ThreadFallback();
         }
 
-        virtual ~EventLoopObject()
-        {
-            if (auto eventLoop = GetEventLoop())
-            {
-                eventLoop->SendEvent([=](){
-                    eventLoop->Quit();
-                });
-            }
+    public:
+        LoopLocal() = default;
+        LoopLocal(const LoopLocal &) = delete;
+        LoopLocal &operator=(const LoopLocal &) = delete;
 
-            if (m_pThread)
-            {
-                delete m_pThread;
-                m_pThread = nullptr;
-            }
+        explicit LoopLocal(std::function<T()> factory) : m_Factory(std::move(factory))
+        {
         }
-    };
 
-    class Timer : public Object
-    {
-    public:
-        ~Timer()
+        ~LoopLocal()
         {
-            Stop();
-            m_timerId = 0;
+            Implementation::LoopLocalStorage::FreeSlot(m_Slot);
         }
 
-        template<typename Callable>
-        static void SingleShot(int interval, Callable&& func)
+        T &Get()
         {
-            auto eventLoop = winSignal::GetEventLoop(std::this_thread::get_id());
-            if (eventLoop)
+            Implementation::LoopLocalStorage &storage = Storage();
+            void *value = storage.Get(m_Slot);
+            if (value == nullptr)
             {
-                eventLoop->SetSingleShotTimer(interval, std::forward<Callable>(func));
+                auto created = m_Factory ? std::make_shared<T>(m_Factory()) : std::make_shared<T>();
+                value = created.get();
+                storage.Set(m_Slot, std::move(created));
             }
+            return *static_cast<T *>(value);
         }
 
-        template<typename Callable>
-        void Start(int interval, Callable&& func)
+        bool HasValue()
         {
-            if (IsAlive())
-                return;
-
-            auto eventLoop = winSignal::GetEventLoop(std::this_thread::get_id());
-            if (eventLoop)
-            {
-                m_timerId = eventLoop->SetRepeatTimer(interval, std::forward<Callable>(func));
-            }
+            return Storage().Get(m_Slot) != nullptr;
         }
 
-        void Start(int interval)
+        void Reset()
         {
-            if (IsAlive())
-                return;
-
-            auto eventLoop = winSignal::GetEventLoop(std::this_thread::get_id());
-            if (eventLoop)
-            {
-                m_timerId = eventLoop->SetRepeatTimer(interval, [&]() {
-                    timeout.Emit();
-                });
-            }
+            Storage().Set(m_Slot, nullptr);
         }
 
-        void Stop()
+        T &operator*()
         {
-            if (!IsAlive())
-                return;
-
-            auto eventLoop = winSignal::GetEventLoop(std::this_thread::get_id());
-            if (eventLoop)
-            {
-                eventLoop->KillTimer(m_timerId);
-                m_timerId = 0;
-            }
+            return Get();
         }
 
-        bool IsAlive()
+        T *operator->()
         {
-            return m_timerId > 0;
+            return &Get();
         }
-
-    public:
-        winSignal::Signal<> timeout;
-
-    private:
-        UINT_PTR m_timerId = 0;
     };
 
-
     template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
     inline constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, void (U::* handler)(SlotArgs...), ConnectionType type)
     {
@@ -1135,15 +6429,16 @@ namespace winSignal
         v_handler.type = type;
         v_handler.id = std::this_thread::get_id();
 
-        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value && Implementation::is_object<U, std::thread::id>::value;
-        constexpr bool is_not_object_v = !Implementation::is_object<T, std::thread::id>::value && !Implementation::is_object<U, std::thread::id>::value;
-        static_assert(is_object_v || is_not_object_v, "Sender and Receiver must both be Object or neither be");
+        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value;
+        constexpr bool is_receiver_object_v = Implementation::is_object<U, std::thread::id>::value;
+        static_assert(is_receiver_object_v || !is_object_v, "An Object sender requires an Object receiver");
         if constexpr (is_object_v)
         {
             auto receiverWeakFlag = receiver->GetWeakFlag();
             auto senderWeakFlag = sender->GetWeakFlag();
             auto eventWeakFlag = (static_cast<T*>(sender)->*event).GetWeakFlag();
             v_handler.id = receiver->ThreadId();
+            v_handler.receiver = static_cast<const Object *>(receiver);
             sender->AddReceiver(ReceiverAddress, [=]()
             {
                 if (!receiverWeakFlag.expired())
@@ -1163,6 +6458,19 @@ namespace winSignal
                 }
             });
         }
+        else if constexpr (is_receiver_object_v)
+        {
+            auto eventWeakFlag = (static_cast<T*>(sender)->*event).GetWeakFlag();
+            v_handler.id = receiver->ThreadId();
+            v_handler.receiver = static_cast<const Object *>(receiver);
+            receiver->AddSender(SenderAddress, ReceiverAddress.function, [=]()
+            {
+                if (!eventWeakFlag.expired())
+                {
+                    (static_cast<T*>(sender)->*event).RemoveHandler(ReceiverAddress);
+                }
+            });
+        }
         (static_cast<T *>(sender)->*event).AddHandler(ReceiverAddress, v_handler);
     }
 
@@ -1173,9 +6481,9 @@ namespace winSignal
         Implementation::Address SenderAddress(sender, event);
         (static_cast<T *>(sender)->*event).RemoveHandler(ReceiverAddress);
 
-        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value && Implementation::is_object<U, std::thread::id>::value;
-        constexpr bool is_not_object_v = !Implementation::is_object<T, std::thread::id>::value && !Implementation::is_object<U, std::thread::id>::value;
-        static_assert(is_object_v || is_not_object_v, "Sender and Receiver must both be Object or neither be");
+        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value;
+        constexpr bool is_receiver_object_v = Implementation::is_object<U, std::thread::id>::value;
+        static_assert(is_receiver_object_v || !is_object_v, "An Object sender requires an Object receiver");
         if constexpr (is_object_v)
         {
             if (sender->ContainReceiver(ReceiverAddress) && receiver->ContainSender(SenderAddress))
@@ -1184,6 +6492,13 @@ namespace winSignal
                 receiver->RemoveSender(SenderAddress, ReceiverAddress.function);
             }
         }
+        else if constexpr (is_receiver_object_v)
+        {
+            if (receiver->ContainSender(SenderAddress))
+            {
+                receiver->RemoveSender(SenderAddress, ReceiverAddress.function);
+            }
+        }
     }
 
     template<typename Sender, typename Receiver, typename T, typename U, typename ...SignalArgs, typename ...SlotArgs>
@@ -1198,15 +6513,16 @@ namespace winSignal
         v_handler.type = type;
         v_handler.id = std::this_thread::get_id();
 
-        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value && Implementation::is_object<U, std::thread::id>::value;
-        constexpr bool is_not_object_v = !Implementation::is_object<T, std::thread::id>::value && !Implementation::is_object<U, std::thread::id>::value;
-        static_assert(is_object_v || is_not_object_v, "Sender and Receiver must both be Object or neither be");
+        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value;
+        constexpr bool is_receiver_object_v = Implementation::is_object<U, std::thread::id>::value;
+        static_assert(is_receiver_object_v || !is_object_v, "An Object sender requires an Object receiver");
         if constexpr (is_object_v)
         {
             auto receiverWeakFlag = receiver->GetWeakFlag();
             auto senderWeakFlag = sender->GetWeakFlag();
             auto eventWeakFlag = (static_cast<T*>(sender)->*event).GetWeakFlag();
             v_handler.id = receiver->ThreadId();
+            v_handler.receiver = static_cast<const Object *>(receiver);
             sender->AddReceiver(ReceiverAddress, [=]()
             {
                  if (!receiverWeakFlag.expired())
@@ -1226,6 +6542,19 @@ namespace winSignal
                  }
             });
         }
+        else if constexpr (is_receiver_object_v)
+        {
+            auto eventWeakFlag = (static_cast<T*>(sender)->*event).GetWeakFlag();
+            v_handler.id = receiver->ThreadId();
+            v_handler.receiver = static_cast<const Object *>(receiver);
+            receiver->AddSender(SenderAddress, ReceiverAddress.function, [=]()
+            {
+                if (!eventWeakFlag.expired())
+                {
+                    (static_cast<T*>(sender)->*event).RemoveHandler(ReceiverAddress);
+                }
+            });
+        }
 
         (static_cast<T *>(sender)->*event).AddHandler(ReceiverAddress, v_handler);
     }
@@ -1237,9 +6566,9 @@ namespace winSignal
         Implementation::Address SenderAddress(sender, event);
         (static_cast<T *>(sender)->*event).RemoveHandler(ReceiverAddress);
 
-        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value && Implementation::is_object<U, std::thread::id>::value;
-        constexpr bool is_not_object_v = !Implementation::is_object<T, std::thread::id>::value && !Implementation::is_object<U, std::thread::id>::value;
-        static_assert(is_object_v || is_not_object_v, "Sender and Receiver must both be Object or neither be");
+        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value;
+        constexpr bool is_receiver_object_v = Implementation::is_object<U, std::thread::id>::value;
+        static_assert(is_receiver_object_v || !is_object_v, "An Object sender requires an Object receiver");
         if constexpr (is_object_v)
         {
             if (sender->ContainReceiver(ReceiverAddress) && receiver->ContainSender(SenderAddress))
@@ -1248,6 +6577,13 @@ namespace winSignal
                 receiver->RemoveSender(SenderAddress, ReceiverAddress.function);
             }
         }
+        else if constexpr (is_receiver_object_v)
+        {
+            if (receiver->ContainSender(SenderAddress))
+            {
+                receiver->RemoveSender(SenderAddress, ReceiverAddress.function);
+            }
+        }
     }
 
     template<typename Sender, typename T, typename ...SignalArgs, typename ...SlotArgs>
@@ -1272,9 +6608,9 @@ namespace winSignal
     template<typename Sender, typename Receiver, typename T, typename Lambda, typename ...SignalArgs>
     inline constexpr void Connect(Sender *sender, Signal<SignalArgs...> T::* event, Receiver *receiver, Lambda &&lambda, ConnectionType type)
     {
-        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value && Implementation::is_object<Receiver, std::thread::id>::value;
-        constexpr bool is_not_object_v = !Implementation::is_object<T, std::thread::id>::value && !Implementation::is_object<Receiver, std::thread::id>::value;
-        static_assert(is_object_v || is_not_object_v, "Sender and Receiver must both be Object or neither be");
+        constexpr bool is_object_v = Implementation::is_object<T, std::thread::id>::value;
+        constexpr bool is_receiver_object_v = Implementation::is_object<Receiver, std::thread::id>::value;
+        static_assert(is_receiver_object_v || !is_object_v, "An Object sender requires an Object receiver");
         Implementation::Address SenderAddress(sender, event);
         auto &&ReceiverAddress = (sender->*event).ImitationFunctionHelper(receiver, lambda, &Lambda::operator(), type);
         if constexpr (is_object_v)
@@ -1301,6 +6637,17 @@ namespace winSignal
                 }
             });
         }
+        else if constexpr (is_receiver_object_v)
+        {
+            auto eventWeakFlag = (static_cast<T*>(sender)->*event).GetWeakFlag();
+            receiver->AddSender(SenderAddress, ReceiverAddress.function, [=]()
+            {
+                if (!eventWeakFlag.expired())
+                {
+                    (static_cast<T*>(sender)->*event).RemoveHandler(ReceiverAddress);
+                }
+            });
+        }
     }
 
     template<typename Sender, typename T, typename Lambda, typename ...SignalArgs>
@@ -1319,6 +6666,16 @@ namespace winSignal
         return GetEventLoop(std::this_thread::get_id());
     }
 
+    inline std::size_t Broadcast(std::function<void()> func, std::function<void(std::chrono::steady_clock::duration)> done = nullptr)
+    {
+        return Implementation::EventLoopManager::GetInstance()->Broadcast(std::move(func), std::move(done));
+    }
+
+    inline BroadcastResult BroadcastAndWait(std::function<void()> func, std::chrono::steady_clock::duration timeout = (std::chrono::steady_clock::duration::max)())
+    {
+        return Implementation::EventLoopManager::GetInstance()->BroadcastAndWait(std::move(func), timeout);
+    }
+
     inline EventLoop *GetEventLoop(const Thread &thread)
     {
         return GetEventLoop(thread.GetID());